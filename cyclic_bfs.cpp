@@ -3,6 +3,9 @@
 #include <queue>
 #include <algorithm>
 #include <numeric>
+#include <limits>
+#include <cstdint>
+#include <type_traits>
 
 void printGraph(const std::vector<std::vector<int>>& adjMatrix) {
     std::cout << "Graph Adjacency Matrix:" << std::endl;
@@ -15,19 +18,30 @@ void printGraph(const std::vector<std::vector<int>>& adjMatrix) {
     std::cout << "-------------------------" << std::endl;
 }
 
+// VertexId sizes the per-vertex arrays (in-degrees, parents, the queue):
+// uint16_t for small graphs, uint32_t by default, uint64_t beyond 2^32
+// vertices. Its maximum value is reserved as the "no parent" marker.
+template <typename VertexId = uint32_t>
 void detectCycleBFS(const std::vector<std::vector<int>>& adjMatrix) {
-    int numVertices = adjMatrix.size();
-    if (numVertices == 0) {
+    static_assert(std::is_unsigned<VertexId>::value, "VertexId must be an unsigned integer type");
+    const VertexId NONE = std::numeric_limits<VertexId>::max();
+
+    if (adjMatrix.empty()) {
         std::cout << "Graph is empty." << std::endl;
         return;
     }
+    if (adjMatrix.size() > static_cast<size_t>(NONE)) {
+        std::cout << "Graph has too many vertices for a " << 8 * sizeof(VertexId) << "-bit vertex index." << std::endl;
+        return;
+    }
+    VertexId numVertices = static_cast<VertexId>(adjMatrix.size());
 
-    std::vector<int> inDegree(numVertices, 0);
-    std::vector<int> parent(numVertices, -1);
+    std::vector<VertexId> inDegree(numVertices, 0);
+    std::vector<VertexId> parent(numVertices, NONE);
 
     // Calculate in-degrees for all vertices
-    for (int i = 0; i < numVertices; ++i) {
-        for (int j = 0; j < numVertices; ++j) {
+    for (VertexId i = 0; i < numVertices; ++i) {
+        for (VertexId j = 0; j < numVertices; ++j) {
             if (adjMatrix[i][j] == 1) {
                 inDegree[j]++;
             }
@@ -35,25 +49,23 @@ void detectCycleBFS(const std::vector<std::vector<int>>& adjMatrix) {
     }
 
     // Initialize queue with all vertices having an in-degree of 0
-    std::queue<int> q;
-    for (int i = 0; i < numVertices; ++i) {
+    std::queue<VertexId> q;
+    for (VertexId i = 0; i < numVertices; ++i) {
         if (inDegree[i] == 0) {
             q.push(i);
         }
     }
 
-    int processedCount = 0;
+    VertexId processedCount = 0;
     while (!q.empty()) {
-        int u = q.front();
+        VertexId u = q.front();
         q.pop();
         processedCount++;
 
         // Iterate through all neighbors of u
-        for (int v = 0; v < numVertices; ++v) {
+        for (VertexId v = 0; v < numVertices; ++v) {
             if (adjMatrix[u][v] == 1) {
                 inDegree[v]--;
-               
-                parent[v] = u; 
                 if (inDegree[v] == 0) {
                     q.push(v);
                 }
@@ -66,18 +78,30 @@ void detectCycleBFS(const std::vector<std::vector<int>>& adjMatrix) {
         std::cout << "Result (BFS): Graph is CYCLIC." << std::endl;
 
         // Find a node that is part of a cycle (in-degree > 0)
-        int cycleNode = -1;
-        for (int i = 0; i < numVertices; ++i) {
+        VertexId cycleNode = NONE;
+        for (VertexId i = 0; i < numVertices; ++i) {
             if (inDegree[i] > 0) {
                 cycleNode = i;
                 break;
             }
         }
 
+        // Every unprocessed vertex keeps a predecessor that is also
+        // unprocessed; following those parents stays inside the remainder
+        for (VertexId v = 0; v < numVertices; ++v) {
+            if (inDegree[v] == 0) continue;
+            for (VertexId u = 0; u < numVertices; ++u) {
+                if (adjMatrix[u][v] == 1 && inDegree[u] > 0) {
+                    parent[v] = u;
+                    break;
+                }
+            }
+        }
+
         // Reconstruct cycle by tracing back parents
-        std::vector<int> cyclePath;
+        std::vector<VertexId> cyclePath;
         std::vector<bool> visitedInCycle(numVertices, false);
-        int current = cycleNode;
+        VertexId current = cycleNode;
         
         while (!visitedInCycle[current]) {
             visitedInCycle[current] = true;
@@ -85,7 +109,7 @@ void detectCycleBFS(const std::vector<std::vector<int>>& adjMatrix) {
         }
 
         // `current` is the start of the cycle
-        int cycleStartNode = current;
+        VertexId cycleStartNode = current;
         do {
             cyclePath.push_back(current);
             current = parent[current];
@@ -95,9 +119,9 @@ void detectCycleBFS(const std::vector<std::vector<int>>& adjMatrix) {
         
         std::cout << "Vertices in a cycle: ";
         for (size_t i = 0; i < cyclePath.size(); ++i) {
-            std::cout << cyclePath[i] << (i == cyclePath.size() - 1 ? "" : " -> ");
+            std::cout << +cyclePath[i] << (i == cyclePath.size() - 1 ? "" : " -> ");
         }
-        std::cout << " -> " << cyclePath[0] << std::endl;
+        std::cout << " -> " << +cyclePath[0] << std::endl;
 
     } else {
         std::cout << "Result (BFS): Graph is ACYCLIC." << std::endl;
@@ -117,6 +141,11 @@ int main() {
     };
     printGraph(cyclicGraph);
     detectCycleBFS(cyclicGraph);
+
+    // Same graph with the narrowest and widest vertex index types
+    std::cout << "\n--- Test Case: 16-bit and 64-bit Vertex Index ---" << std::endl;
+    detectCycleBFS<uint16_t>(cyclicGraph);
+    detectCycleBFS<uint64_t>(cyclicGraph);
     
     return 0;
 }
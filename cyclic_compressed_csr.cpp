@@ -0,0 +1,602 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#if defined(__x86_64__) || defined(__i386__)
+#define CYCLIC_X86 1
+#include <immintrin.h>
+#endif
+
+// Gap-encoded CSR in the Stream VByte layout.
+//
+// Each neighbor list is sorted and turned into gaps: the first neighbor is
+// stored relative to the vertex itself (zigzag encoded, since it may be
+// smaller), the rest relative to the previous neighbor. Gaps are written in
+// groups of four: one control byte holding four 2-bit lengths (1-4 bytes),
+// followed later by the data bytes of the group. Per vertex the stream holds
+// the degree as a varint, all control bytes of its list, then all data
+// bytes. A list is found through a 32-bit offset relative to a 64-bit base
+// shared by 64 vertices, so a vertex costs about 5 bytes besides its gaps
+// (degree and 64-bit start arrays would cost 12). A group decodes
+// with one 16-byte load, one byte shuffle picked by the control byte and a
+// 4-lane prefix sum. Engines walk the lists through a cursor that decodes
+// one group at a time, so a DFS frame can stop and resume inside a list
+// without ever expanding it.
+//
+// The group decoder is chosen at startup from what the CPU reports, not from
+// the build flags, so one binary serves every host:
+//   scalar  masked 4-byte loads, any CPU
+//   ssse3   one group per 128-bit shuffle
+//   avx2    two groups per 256-bit shuffle, prefix carried across lanes
+//   avx512  four groups per 512-bit shuffle (AVX-512F + BW)
+// Whole-list scans use the widest tier; a cursor and a list's first and
+// trailing groups always go one group at a time. `--decoder=<tier>` forces
+// a tier, e.g. to benchmark them against each other.
+
+// The first gap is a 32-bit wraparound difference, so any pair of ids
+// encodes and decoding with unsigned arithmetic restores it exactly
+inline uint32_t zigzag(int32_t x) { return (static_cast<uint32_t>(x) << 1) ^ static_cast<uint32_t>(x >> 31); }
+inline uint32_t unzigzag(uint32_t z) { return (z >> 1) ^ -(z & 1); }
+
+// Per control byte: bytes consumed by the group and the shuffle mask
+// placing each length-prefixed gap in its own 32-bit lane
+struct GroupTables {
+    uint8_t length[256];
+    alignas(16) uint8_t shuffle[256][16];
+    GroupTables() {
+        for (int c = 0; c < 256; ++c) {
+            int src = 0;
+            for (int k = 0; k < 4; ++k) {
+                int len = ((c >> (2 * k)) & 3) + 1;
+                for (int b = 0; b < 4; ++b) shuffle[c][4 * k + b] = b < len ? src + b : 0x80;
+                src += len;
+            }
+            length[c] = src;
+        }
+    }
+};
+const GroupTables& groupTables() {
+    static const GroupTables t;
+    return t;
+}
+
+// Group kernels, one struct per instruction set tier. decodeOne decodes the
+// four gaps of one group into absolute neighbor ids, starting from
+// `previous`; for a list's first group `firstVertex` is the owning vertex
+// (lane 0 is a zigzagged offset from it), otherwise UINT32_MAX. decodeRun
+// decodes `GROUPS_PER_RUN` consecutive full groups that are not a list's
+// first. Both return the data bytes consumed (the stream is padded, so
+// loads may run up to 16 bytes past a group).
+
+// Unaligned 4-byte loads masked to each gap's length
+struct ScalarGroups {
+    static constexpr uint32_t GROUPS_PER_RUN = 1;
+
+    static size_t decodeOne(uint8_t c, const uint8_t* data, uint32_t previous, uint32_t firstVertex, uint32_t* out) {
+        static const uint32_t mask[4] = {0xff, 0xffff, 0xffffff, 0xffffffff};
+        const uint8_t* p = data;
+        uint32_t value = previous;
+        for (int k = 0; k < 4; ++k) {
+            int code = (c >> (2 * k)) & 3;
+            uint32_t g;
+            std::memcpy(&g, p, 4);
+            g &= mask[code];
+            p += code + 1;
+            value = (k == 0 && firstVertex != UINT32_MAX) ? firstVertex + unzigzag(g) : value + g;
+            out[k] = value;
+        }
+        return p - data;
+    }
+
+    static size_t decodeRun(const uint8_t* control, const uint8_t* data, uint32_t previous, uint32_t* out) {
+        return decodeOne(*control, data, previous, UINT32_MAX, out);
+    }
+};
+
+#if CYCLIC_X86
+// One group per 128-bit shuffle
+struct Ssse3Groups {
+    static constexpr uint32_t GROUPS_PER_RUN = 1;
+
+    __attribute__((target("ssse3")))
+    static size_t decodeOne(uint8_t c, const uint8_t* data, uint32_t previous, uint32_t firstVertex, uint32_t* out) {
+        __m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)),
+                                     _mm_load_si128(reinterpret_cast<const __m128i*>(groupTables().shuffle[c])));
+        if (firstVertex != UINT32_MAX) {
+            uint32_t g0 = _mm_cvtsi128_si32(x);
+            x = _mm_add_epi32(x, _mm_cvtsi32_si128(firstVertex + unzigzag(g0) - g0));
+        }
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, _mm_set1_epi32(previous));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), x);
+        return groupTables().length[c];
+    }
+
+    __attribute__((target("ssse3")))
+    static size_t decodeRun(const uint8_t* control, const uint8_t* data, uint32_t previous, uint32_t* out) {
+        return decodeOne(*control, data, previous, UINT32_MAX, out);
+    }
+};
+
+// Two groups, one per 128-bit lane; the low lane's total is then added to
+// the high lane
+struct Avx2Groups {
+    static constexpr uint32_t GROUPS_PER_RUN = 2;
+
+    __attribute__((target("avx2")))
+    static size_t decodeOne(uint8_t c, const uint8_t* data, uint32_t previous, uint32_t firstVertex, uint32_t* out) {
+        return Ssse3Groups::decodeOne(c, data, previous, firstVertex, out);
+    }
+
+    __attribute__((target("avx2")))
+    static size_t decodeRun(const uint8_t* control, const uint8_t* data, uint32_t previous, uint32_t* out) {
+        const GroupTables& t = groupTables();
+        uint8_t c0 = control[0], c1 = control[1];
+        size_t second = t.length[c0];
+        __m256i x = _mm256_set_m128i(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + second)),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+        __m256i shuffle = _mm256_set_m128i(_mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[c1])),
+                                           _mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[c0])));
+        x = _mm256_shuffle_epi8(x, shuffle);
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+        __m256i carry = _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(3));
+        carry = _mm256_blend_epi32(_mm256_setzero_si256(), carry, 0xf0);
+        x = _mm256_add_epi32(x, _mm256_add_epi32(carry, _mm256_set1_epi32(previous)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), x);
+        return second + t.length[c1];
+    }
+};
+
+// Four groups, one per 128-bit lane; lane totals are combined with a 4-lane
+// exclusive prefix sum
+struct Avx512Groups {
+    static constexpr uint32_t GROUPS_PER_RUN = 4;
+
+    __attribute__((target("avx512f,avx512bw")))
+    static size_t decodeOne(uint8_t c, const uint8_t* data, uint32_t previous, uint32_t firstVertex, uint32_t* out) {
+        return Ssse3Groups::decodeOne(c, data, previous, firstVertex, out);
+    }
+
+    __attribute__((target("avx512f,avx512bw")))
+    static size_t decodeRun(const uint8_t* control, const uint8_t* data, uint32_t previous, uint32_t* out) {
+        const GroupTables& t = groupTables();
+        __m512i x = _mm512_setzero_si512(), shuffle = _mm512_setzero_si512();
+        size_t offset = 0;
+        for (int k = 0; k < 4; ++k) {
+            uint8_t c = control[k];
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+            __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[c]));
+            x = _mm512_mask_broadcast_i32x4(x, 0xf << (4 * k), bytes);
+            shuffle = _mm512_mask_broadcast_i32x4(shuffle, 0xf << (4 * k), mask);
+            offset += t.length[c];
+        }
+        x = _mm512_shuffle_epi8(x, shuffle);
+        x = _mm512_add_epi32(x, _mm512_bslli_epi128(x, 4));
+        x = _mm512_add_epi32(x, _mm512_bslli_epi128(x, 8));
+        // Broadcast each lane's total within the lane, prefix-sum across lanes
+        // (shifting whole lanes up), then shift once more for the exclusive sum
+        const __m512i zero = _mm512_setzero_si512();
+        __m512i sum = _mm512_maskz_permutexvar_epi32(0xffff, _mm512_setr_epi32(3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15), x);
+        sum = _mm512_add_epi32(sum, _mm512_maskz_alignr_epi32(0xffff, sum, zero, 12));
+        sum = _mm512_add_epi32(sum, _mm512_maskz_alignr_epi32(0xffff, sum, zero, 8));
+        sum = _mm512_maskz_alignr_epi32(0xffff, sum, zero, 12);
+        x = _mm512_add_epi32(x, _mm512_add_epi32(sum, _mm512_set1_epi32(previous)));
+        _mm512_storeu_si512(out, x);
+        return offset;
+    }
+};
+#endif
+
+class CompressedCSR {
+public:
+    // Build from a plain CSR (neighbor lists need not be sorted)
+    CompressedCSR(const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& targets) {
+        uint32_t n = offsets.size() - 1;
+        base.reserve((n + VERTICES_PER_BASE - 1) / VERTICES_PER_BASE);
+        offset.resize(n);
+        std::vector<uint32_t> list, gaps;
+        for (uint32_t v = 0; v < n; ++v) {
+            list.assign(targets.begin() + offsets[v], targets.begin() + offsets[v + 1]);
+            std::sort(list.begin(), list.end());
+            gaps.resize(list.size());
+            for (size_t i = 0; i < list.size(); ++i) gaps[i] = i == 0 ? zigzag(static_cast<int32_t>(list[0] - v)) : list[i] - list[i - 1];
+
+            if (v % VERTICES_PER_BASE == 0) base.push_back(bytes.size());
+            if (bytes.size() - base.back() > UINT32_MAX) throw std::length_error("lists of 64 vertices exceed 4 GB");
+            offset[v] = bytes.size() - base.back();
+            uint32_t degree = list.size();
+            for (; degree >= 0x80; degree >>= 7) bytes.push_back(degree | 0x80);
+            bytes.push_back(degree);
+            size_t controlPos = bytes.size();
+            bytes.resize(bytes.size() + (gaps.size() + 3) / 4, 0);
+            for (size_t i = 0; i < gaps.size(); ++i) {
+                uint32_t g = gaps[i];
+                int len = g < (1u << 8) ? 1 : g < (1u << 16) ? 2 : g < (1u << 24) ? 3 : 4;
+                bytes[controlPos + i / 4] |= (len - 1) << (2 * (i % 4));
+                for (int b = 0; b < len; ++b) bytes.push_back(g >> (8 * b));
+            }
+        }
+        bytes.resize(bytes.size() + 16, 0); // a group load may read 16 bytes past the end
+        bytes.shrink_to_fit();
+    }
+
+    uint32_t numVertices() const { return offset.size(); }
+    size_t memoryBytes() const { return bytes.size() + offset.size() * 4 + base.size() * 8; }
+
+    // Resumable position inside one neighbor list
+    template <class Groups>
+    class GroupCursor {
+    public:
+        bool next(uint32_t& out) {
+            if (pos == filled) {
+                if (remaining == 0) return false;
+                refill();
+            }
+            out = buffer[pos++];
+            return true;
+        }
+
+    private:
+        friend class CompressedCSR;
+
+        void refill() {
+            data += Groups::decodeOne(*control++, data, first ? 0 : previous, first ? vertex : UINT32_MAX, buffer);
+            first = false;
+            filled = std::min<uint32_t>(4, remaining);
+            remaining -= filled;
+            previous = buffer[filled - 1];
+            pos = 0;
+        }
+
+        const uint8_t* control;
+        const uint8_t* data;
+        uint32_t vertex, remaining, previous = 0;
+        uint32_t buffer[4];
+        uint32_t pos = 0, filled = 0;
+        bool first = true;
+    };
+
+    template <class Groups>
+    GroupCursor<Groups> neighbors(uint32_t v) const {
+        GroupCursor<Groups> c;
+        c.vertex = v;
+        c.control = list(v, c.remaining);
+        c.data = c.control + (c.remaining + 3) / 4;
+        return c;
+    }
+
+    // Whole-list walk without the cursor's per-neighbor bookkeeping: the
+    // first group on its own (it carries the offset from v), then runs of
+    // full groups through the widest kernel, then the remaining groups
+    template <class Groups, class F>
+    void forEachNeighbor(uint32_t v, F f) const {
+        uint32_t remaining;
+        const uint8_t* control = list(v, remaining);
+        if (remaining == 0) return;
+        const uint8_t* data = control + (remaining + 3) / 4;
+        uint32_t buffer[4 * Groups::GROUPS_PER_RUN];
+        uint32_t count = std::min<uint32_t>(4, remaining);
+        data += Groups::decodeOne(*control++, data, 0, v, buffer);
+        for (uint32_t k = 0; k < count; ++k) f(buffer[k]);
+        uint32_t previous = buffer[count - 1];
+        remaining -= count;
+
+        const uint32_t runLength = 4 * Groups::GROUPS_PER_RUN;
+        while (remaining >= runLength) {
+            data += Groups::decodeRun(control, data, previous, buffer);
+            control += Groups::GROUPS_PER_RUN;
+            for (uint32_t k = 0; k < runLength; ++k) f(buffer[k]);
+            previous = buffer[runLength - 1];
+            remaining -= runLength;
+        }
+        while (remaining > 0) {
+            count = std::min<uint32_t>(4, remaining);
+            data += Groups::decodeOne(*control++, data, previous, UINT32_MAX, buffer);
+            for (uint32_t k = 0; k < count; ++k) f(buffer[k]);
+            previous = buffer[count - 1];
+            remaining -= count;
+        }
+    }
+
+    // The graph interface the engines expect, decoding with one kernel tier
+    template <class Groups>
+    struct View {
+        using Cursor = GroupCursor<Groups>;
+        const CompressedCSR& g;
+
+        uint32_t numVertices() const { return g.numVertices(); }
+        Cursor neighbors(uint32_t v) const { return g.neighbors<Groups>(v); }
+        template <class F>
+        void forEachNeighbor(uint32_t v, F f) const { g.forEachNeighbor<Groups>(v, f); }
+    };
+
+    template <class Groups>
+    View<Groups> view() const { return {*this}; }
+
+private:
+    // Reads v's degree; returns its first control byte
+    const uint8_t* list(uint32_t v, uint32_t& degree) const {
+        const uint8_t* p = &bytes[base[v / VERTICES_PER_BASE] + offset[v]];
+        degree = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t b = *p++;
+            degree |= static_cast<uint32_t>(b & 0x7f) << shift;
+            if (b < 0x80) return p;
+        }
+    }
+
+    static constexpr uint32_t VERTICES_PER_BASE = 64;
+    std::vector<uint8_t> bytes;
+    std::vector<uint64_t> base;   // byte position of every 64th vertex's list
+    std::vector<uint32_t> offset; // byte position of each list relative to its base
+};
+
+// Plain CSR exposing the same iteration, as the baseline
+struct PlainCSR {
+    std::vector<uint32_t> offsets, targets;
+
+    uint32_t numVertices() const { return offsets.size() - 1; }
+    size_t memoryBytes() const { return (offsets.size() + targets.size()) * 4; }
+
+    class Cursor {
+    public:
+        bool next(uint32_t& out) {
+            if (p == end) return false;
+            out = *p++;
+            return true;
+        }
+
+    private:
+        friend struct PlainCSR;
+        const uint32_t* p;
+        const uint32_t* end;
+    };
+
+    Cursor neighbors(uint32_t v) const {
+        Cursor c;
+        c.p = targets.data() + offsets[v];
+        c.end = targets.data() + offsets[v + 1];
+        return c;
+    }
+
+    template <class F>
+    void forEachNeighbor(uint32_t v, F f) const {
+        for (uint32_t i = offsets[v]; i < offsets[v + 1]; ++i) f(targets[i]);
+    }
+};
+
+// Kahn's algorithm; if vertices remain, a DFS whose frames hold list
+// cursors finds a cycle among them.
+template <typename Graph>
+std::vector<uint32_t> detectCycleGraph(const Graph& g) {
+    uint32_t n = g.numVertices();
+    std::vector<uint32_t> inDegree(n, 0);
+    for (uint32_t v = 0; v < n; ++v) g.forEachNeighbor(v, [&](uint32_t t) { inDegree[t]++; });
+
+    std::vector<uint32_t> queue;
+    queue.reserve(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (inDegree[v] == 0) queue.push_back(v);
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        g.forEachNeighbor(queue[head], [&](uint32_t t) {
+            if (--inDegree[t] == 0) queue.push_back(t);
+        });
+    }
+    if (queue.size() == n) return {};
+
+    std::vector<uint8_t> state(n, 0); // 0 = unvisited, 1 = on stack, 2 = done
+    std::vector<std::pair<uint32_t, typename Graph::Cursor>> stack;
+    for (uint32_t root = 0; root < n; ++root) {
+        if (inDegree[root] == 0 || state[root] != 0) continue;
+        stack.push_back({root, g.neighbors(root)});
+        state[root] = 1;
+        while (!stack.empty()) {
+            uint32_t v;
+            if (!stack.back().second.next(v)) {
+                state[stack.back().first] = 2;
+                stack.pop_back();
+                continue;
+            }
+            if (state[v] == 1) {
+                size_t k = stack.size();
+                while (stack[k - 1].first != v) --k;
+                std::vector<uint32_t> cycle;
+                for (size_t i = k - 1; i < stack.size(); ++i) cycle.push_back(stack[i].first);
+                return cycle;
+            }
+            if (state[v] == 0 && inDegree[v] > 0) {
+                state[v] = 1;
+                stack.push_back({v, g.neighbors(v)});
+            }
+        }
+    }
+    return {};
+}
+
+// Dispatch table. Each tier's traversal is compiled for its instruction set
+// and flattened, so the engine and the group kernels end up in one body and
+// the tier is chosen once per traversal rather than once per group.
+struct GroupDecoder {
+    const char* name;
+    bool (*supported)();
+    std::vector<uint32_t> (*detectCycle)(const CompressedCSR& g);
+    // One list, through a cursor or through the whole-list walk
+    std::vector<uint32_t> (*decodeList)(const CompressedCSR& g, uint32_t v, bool cursor);
+};
+
+template <class Groups>
+std::vector<uint32_t> decodeListWith(const CompressedCSR& g, uint32_t v, bool cursor) {
+    std::vector<uint32_t> list;
+    if (cursor) {
+        CompressedCSR::GroupCursor<Groups> c = g.neighbors<Groups>(v);
+        for (uint32_t t; c.next(t);) list.push_back(t);
+    } else {
+        g.forEachNeighbor<Groups>(v, [&](uint32_t t) { list.push_back(t); });
+    }
+    return list;
+}
+
+bool alwaysSupported() { return true; }
+
+std::vector<uint32_t> detectCycleScalar(const CompressedCSR& g) { return detectCycleGraph(g.view<ScalarGroups>()); }
+
+#if CYCLIC_X86
+bool ssse3Supported() { return __builtin_cpu_supports("ssse3"); }
+bool avx2Supported() { return __builtin_cpu_supports("avx2"); }
+bool avx512Supported() { return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"); }
+
+__attribute__((target("ssse3"), flatten))
+std::vector<uint32_t> detectCycleSsse3(const CompressedCSR& g) { return detectCycleGraph(g.view<Ssse3Groups>()); }
+
+__attribute__((target("avx2"), flatten))
+std::vector<uint32_t> detectCycleAvx2(const CompressedCSR& g) { return detectCycleGraph(g.view<Avx2Groups>()); }
+
+__attribute__((target("avx512f,avx512bw"), flatten))
+std::vector<uint32_t> detectCycleAvx512(const CompressedCSR& g) { return detectCycleGraph(g.view<Avx512Groups>()); }
+#endif
+
+// Tiers from slowest to fastest
+const GroupDecoder groupDecoders[] = {
+    {"scalar", alwaysSupported, detectCycleScalar, decodeListWith<ScalarGroups>},
+#if CYCLIC_X86
+    {"ssse3", ssse3Supported, detectCycleSsse3, decodeListWith<Ssse3Groups>},
+    {"avx2", avx2Supported, detectCycleAvx2, decodeListWith<Avx2Groups>},
+    {"avx512", avx512Supported, detectCycleAvx512, decodeListWith<Avx512Groups>},
+#endif
+};
+
+const GroupDecoder& bestGroupDecoder() {
+    const GroupDecoder* best = &groupDecoders[0];
+    for (const GroupDecoder& d : groupDecoders) {
+        if (d.supported()) best = &d;
+    }
+    return *best;
+}
+
+// The tier with the given name, or nullptr if unknown or unsupported here
+const GroupDecoder* findGroupDecoder(const std::string& name) {
+    for (const GroupDecoder& d : groupDecoders) {
+        if (name == d.name) return d.supported() ? &d : nullptr;
+    }
+    return nullptr;
+}
+
+void printCycle(const std::vector<uint32_t>& cycle) {
+    if (cycle.empty()) {
+        std::cout << "Result: Graph is ACYCLIC." << std::endl;
+        return;
+    }
+    std::cout << "Result: Graph is CYCLIC. Vertices in a cycle: ";
+    for (uint32_t v : cycle) std::cout << v << " -> ";
+    std::cout << cycle[0] << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "--- Stream VByte Compressed CSR ---" << std::endl;
+    // --decoder=<tier> pins one tier; otherwise every supported tier is
+    // benchmarked and the best one is used for the test cases
+    const GroupDecoder* forced = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--decoder=", 0) != 0) continue;
+        forced = findGroupDecoder(arg.substr(10));
+        if (!forced) {
+            std::cerr << "Error: decoder '" << arg.substr(10) << "' is unknown or not supported by this CPU" << std::endl;
+            return 1;
+        }
+    }
+    const GroupDecoder& decoder = forced ? *forced : bestGroupDecoder();
+    std::cout << "Group decoders supported:";
+    for (const GroupDecoder& d : groupDecoders) {
+        if (d.supported()) std::cout << " " << d.name;
+    }
+    std::cout << "; using " << decoder.name << (forced ? " (forced)" : "") << std::endl;
+
+    // Example: the 4-vertex test case
+    std::cout << "\n--- Test Case: Cyclic Graph ---" << std::endl;
+    PlainCSR small{{0, 1, 3, 3, 4}, {1, 2, 3, 1}};
+    printCycle(decoder.detectCycle(CompressedCSR(small.offsets, small.targets)));
+
+    // Example: one list mixing 1- to 4-byte gaps and a neighbor below the vertex
+    std::cout << "\n--- Test Case: Gap Widths ---" << std::endl;
+    CompressedCSR wide({0, 7}, {4000000000u, 0, 300, 2, 70000, 20000000, 301});
+    std::cout << "Decoded neighbors: ";
+    for (uint32_t t : decoder.decodeList(wide, 0, false)) std::cout << t << " ";
+    std::cout << std::endl;
+
+    // Example: first gaps of 2^31 and more, in both directions
+    std::cout << "\n--- Test Case: Large Vertex Ids ---" << std::endl;
+    CompressedCSR large({0, 2, 2, 4}, {3000000000u, 3000000005u, 1, 4294967295u});
+    std::vector<uint32_t> expectedLarge = {3000000000u, 3000000005u, 1, 4294967295u};
+    for (const GroupDecoder& d : groupDecoders) {
+        if (!d.supported()) continue;
+        std::vector<uint32_t> got = d.decodeList(large, 0, false), back = d.decodeList(large, 2, true);
+        got.insert(got.end(), back.begin(), back.end());
+        std::cout << d.name << ": " << (got == expectedLarge ? "OK" : "MISMATCH") << std::endl;
+    }
+
+    // Example: a long list with random gap widths decodes identically in
+    // every tier, through both the cursor and the whole-list walk
+    std::cout << "\n--- Test Case: Decoder Tiers Agree ---" << std::endl;
+    std::mt19937 listRng(3);
+    std::vector<uint32_t> list;
+    for (int i = 0; i < 1001; ++i) list.push_back(listRng() >> (listRng() % 32));
+    CompressedCSR mixed({0, 0, static_cast<uint32_t>(list.size())}, list);
+    std::sort(list.begin(), list.end());
+    for (const GroupDecoder& d : groupDecoders) {
+        if (!d.supported()) continue;
+        bool same = d.decodeList(mixed, 1, false) == list && d.decodeList(mixed, 1, true) == list;
+        std::cout << d.name << ": " << (same ? "OK" : "MISMATCH") << std::endl;
+    }
+
+    // Throughput: 4M vertices, 16 forward neighbors each within a window of
+    // 4096, plus one back edge closing a cycle
+    std::cout << "\n--- Throughput: 4M Vertices, 64M Edges ---" << std::endl;
+    const uint32_t n = 1 << 22, degreePerVertex = 16, window = 4096;
+    std::mt19937 rng(17);
+    PlainCSR plain;
+    plain.offsets.reserve(n + 1);
+    plain.targets.reserve(static_cast<size_t>(n) * degreePerVertex + 1);
+    plain.offsets.push_back(0);
+    for (uint32_t v = 0; v < n; ++v) {
+        for (uint32_t d = 0; d < degreePerVertex; ++d) {
+            uint32_t t = v + 1 + rng() % window;
+            if (t < n) plain.targets.push_back(t);
+        }
+        if (v == n - 1) plain.targets.push_back(n / 2);
+        plain.offsets.push_back(plain.targets.size());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    CompressedCSR compressed(plain.offsets, plain.targets);
+    double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Edges: " << plain.targets.size() << ", plain CSR: " << (plain.memoryBytes() >> 20)
+              << " MB, compressed: " << (compressed.memoryBytes() >> 20) << " MB ("
+              << static_cast<double>(plain.memoryBytes()) / compressed.memoryBytes() << "x), build " << buildSeconds << " s"
+              << std::endl;
+
+    auto measure = [&](const std::string& name, auto detect) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint32_t> cycle = detect();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << seconds << " s (" << static_cast<long long>(plain.targets.size() / seconds)
+                  << " edges/s), cycle length " << cycle.size() << std::endl;
+        return seconds;
+    };
+    double plainSeconds = measure("plain CSR", [&] { return detectCycleGraph(plain); });
+    for (const GroupDecoder& d : groupDecoders) {
+        if (!d.supported() || (forced && &d != &decoder)) continue;
+        double compressedSeconds = measure(std::string("compressed CSR, ") + d.name, [&] { return d.detectCycle(compressed); });
+        std::cout << "  compressed / plain time: " << compressedSeconds / plainSeconds << std::endl;
+    }
+
+    return 0;
+}
@@ -1,13 +1,21 @@
 #include <iostream>
 #include <vector>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
 using namespace std;
 
-bool dfs(int v, vector<vector<int>>& adjMatrix, vector<bool>& visited, vector<bool>& recStack, vector<int>& path) {
+// VertexId is the index type used for vertices and the cycle path:
+// uint16_t for small graphs, uint32_t by default, uint64_t for huge ones.
+template <typename VertexId>
+bool dfs(VertexId v, vector<vector<int>>& adjMatrix, vector<bool>& visited, vector<bool>& recStack, vector<VertexId>& path) {
     visited[v] = true;
     recStack[v] = true;
     path.push_back(v);
 
-    for (int u = 0; u < adjMatrix.size(); ++u) {
+    VertexId n = static_cast<VertexId>(adjMatrix.size());
+    for (VertexId u = 0; u < n; ++u) {
         if (adjMatrix[v][u]) {
             if (!visited[u]) {
                 if (dfs(u, adjMatrix, visited, recStack, path))
@@ -24,15 +32,19 @@ bool dfs(int v, vector<vector<int>>& adjMatrix, vector<bool>& visited, vector<bo
     return false;
 }
 
+template <typename VertexId = uint32_t>
 bool isCyclicDFS(vector<vector<int>>& adjMatrix) {
-    int n = adjMatrix.size();
+    if (adjMatrix.size() > static_cast<size_t>(numeric_limits<VertexId>::max())) {
+        throw length_error("graph has too many vertices for a vertex index of " + to_string(8 * sizeof(VertexId)) + " bits");
+    }
+    VertexId n = static_cast<VertexId>(adjMatrix.size());
     vector<bool> visited(n, false), recStack(n, false);
-    vector<int> path;
+    vector<VertexId> path;
 
-    for (int i = 0; i < n; ++i) {
+    for (VertexId i = 0; i < n; ++i) {
         if (!visited[i] && dfs(i, adjMatrix, visited, recStack, path)) {
             cout << "Cycle detected (DFS). Vertices in cycle (approximate): ";
-            for (int v : path) cout << v << " ";
+            for (VertexId v : path) cout << +v << " ";
             cout << endl;
             return true;
         }
@@ -50,5 +62,15 @@ int main() {
     };
 
     isCyclicDFS(adjMatrix);
+    isCyclicDFS<uint16_t>(adjMatrix);
+    isCyclicDFS<uint64_t>(adjMatrix);
+
+    // 300 vertices do not fit an 8-bit index: an error, not a verdict
+    vector<vector<int>> wideMatrix(300, vector<int>(300, 0));
+    try {
+        isCyclicDFS<uint8_t>(wideMatrix);
+    } catch (const length_error& e) {
+        cout << "Error: " << e.what() << endl;
+    }
     return 0;
 }
@@ -0,0 +1,681 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <queue>
+#include <map>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <filesystem>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+// Out-of-core cycle detection over a CSR file.
+//
+// The graph lives on disk as [header][offsets][targets], each section
+// aligned to 4 KB. Only per-vertex state is kept in RAM: the offsets (so
+// any adjacency list can be located without an extra read), in-degrees and
+// DFS colors, i.e. O(V) memory for any number of edges. Edges are read with
+// batched asynchronous I/O through io_uring (set up with raw syscalls, so no
+// liburing is needed; if the kernel refuses the ring, reads fall back to
+// synchronous pread). The file is opened with O_DIRECT where supported so
+// reads bypass the page cache; all requests are 4 KB aligned for that.
+//
+//   1. In-degrees: the targets section is streamed in large chunks with
+//      several reads in flight.
+//   2. Kahn: ready vertices are drained in sweeps over the file in id order.
+//      Lists lying close together on disk are coalesced into one read, with
+//      the bytes read beyond them capped, and up to `depth` reads in flight.
+//   3. If vertices remain, a semi-external DFS over them finds a cycle. A
+//      frame holds only a vertex and an edge cursor; the top frame's list is
+//      read back in bounded chunks. On entering a vertex, the lists of its
+//      unvisited successors are prefetched asynchronously into a fixed
+//      budget, so the next step usually finds its list already in memory.
+
+constexpr uint64_t BLOCK = 4096;
+constexpr uint64_t MAGIC = 0x5253436c61637943ULL; // "CyclaCSR"
+
+uint64_t alignUp(uint64_t x) { return (x + BLOCK - 1) / BLOCK * BLOCK; }
+uint64_t alignDown(uint64_t x) { return x / BLOCK * BLOCK; }
+
+struct AlignedFree {
+    void operator()(uint8_t* p) const { std::free(p); }
+};
+using AlignedBuffer = std::unique_ptr<uint8_t, AlignedFree>;
+
+AlignedBuffer allocateAligned(size_t bytes) {
+    void* p = std::aligned_alloc(BLOCK, alignUp(std::max<size_t>(bytes, 1)));
+    if (!p) throw std::bad_alloc();
+    return AlignedBuffer(static_cast<uint8_t*>(p));
+}
+
+// Write a CSR file. `degree(v)` gives the out-degree and
+// `neighbors(v, out)` appends the targets of v; both are called in vertex
+// order, so the graph never has to be held in memory.
+template <typename DegreeFn, typename NeighborsFn>
+void writeDiskCSR(const std::string& path, uint32_t n, DegreeFn degree, NeighborsFn neighbors) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) throw std::runtime_error("cannot create " + path);
+
+    std::vector<uint64_t> offsets(n + 1, 0);
+    for (uint32_t v = 0; v < n; ++v) offsets[v + 1] = offsets[v] + degree(v);
+    uint64_t header[3] = {MAGIC, n, offsets[n]};
+    std::vector<uint8_t> padding(BLOCK, 0);
+    std::fwrite(header, sizeof(header), 1, f);
+    std::fwrite(padding.data(), BLOCK - sizeof(header), 1, f);
+    std::fwrite(offsets.data(), 8, n + 1, f);
+    std::fwrite(padding.data(), alignUp(8 * (n + 1)) - 8 * (n + 1), 1, f);
+
+    std::vector<uint32_t> list;
+    for (uint32_t v = 0; v < n; ++v) {
+        list.clear();
+        neighbors(v, list);
+        std::fwrite(list.data(), 4, list.size(), f);
+    }
+    std::fwrite(padding.data(), alignUp(4 * offsets[n]) - 4 * offsets[n], 1, f);
+    if (std::fclose(f) != 0) throw std::runtime_error("write failed: " + path);
+}
+
+// Reads in flight through an io_uring submission/completion ring pair.
+// Completions carry the caller's tag; a read must return all bytes asked for.
+class AsyncReader {
+public:
+    AsyncReader(int fd, unsigned depth) : fd(fd), depth(depth) {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        ringFd = syscall(__NR_io_uring_setup, depth, &p);
+        if (ringFd < 0) return; // pread fallback
+
+        sqBytes = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cqBytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) sqBytes = cqBytes = std::max(sqBytes, cqBytes);
+        sqRing = mmap(nullptr, sqBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        cqRing = single ? sqRing
+                        : mmap(nullptr, cqBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        sqesBytes = p.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(
+            mmap(nullptr, sqesBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+        if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqes == MAP_FAILED) throw std::runtime_error("io_uring mmap failed");
+
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        this->depth = std::min(depth, p.sq_entries);
+    }
+
+    ~AsyncReader() {
+        if (ringFd < 0) return;
+        munmap(sqes, sqesBytes);
+        if (cqRing != sqRing) munmap(cqRing, cqBytes);
+        munmap(sqRing, sqBytes);
+        close(ringFd);
+    }
+
+    bool usesRing() const { return ringFd >= 0; }
+    bool full() const { return inFlight == depth; }
+    unsigned pending() const { return inFlight; }
+
+    void enqueue(uint64_t offset, uint32_t bytes, uint8_t* buffer, uint64_t tag) {
+        requests++;
+        bytesRead += bytes;
+        inFlight++;
+        if (ringFd < 0) {
+            if (pread(fd, buffer, bytes, offset) != static_cast<ssize_t>(bytes)) throw std::runtime_error("pread failed");
+            done.push_back(tag);
+            return;
+        }
+        unsigned tail = *sqTail, index = tail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64_t>(buffer);
+        sqe.len = bytes;
+        sqe.off = offset;
+        sqe.user_data = tag;
+        expected[tag] = bytes;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        unsubmitted++;
+    }
+
+    // Submit queued reads and return the tag of one finished read
+    uint64_t waitOne() {
+        if (inFlight == 0) throw std::logic_error("no read in flight");
+        inFlight--;
+        if (ringFd < 0) {
+            uint64_t tag = done.back();
+            done.pop_back();
+            return tag;
+        }
+        while (true) {
+            unsigned head = *cqHead;
+            if (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+                io_uring_cqe cqe = cqes[head & cqMask];
+                __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+                auto it = expected.find(cqe.user_data);
+                if (cqe.res < 0 || static_cast<uint32_t>(cqe.res) != it->second) {
+                    throw std::runtime_error(std::string("read failed: ") + (cqe.res < 0 ? std::strerror(-cqe.res) : "short read"));
+                }
+                expected.erase(it);
+                return cqe.user_data;
+            }
+            int submitted = syscall(__NR_io_uring_enter, ringFd, unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted < 0) throw std::runtime_error("io_uring_enter failed");
+            unsubmitted -= submitted;
+        }
+    }
+
+    size_t requests = 0, bytesRead = 0;
+
+private:
+    int fd;
+    unsigned depth, inFlight = 0, unsubmitted = 0;
+    int ringFd = -1;
+    void *sqRing = nullptr, *cqRing = nullptr;
+    size_t sqBytes = 0, cqBytes = 0, sqesBytes = 0;
+    io_uring_sqe* sqes = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned *sqHead, *sqTail, *sqArray, *cqHead, *cqTail;
+    unsigned sqMask = 0, cqMask = 0;
+    std::unordered_map<uint64_t, uint32_t> expected; // tag -> bytes
+    std::vector<uint64_t> done;                      // pread fallback
+};
+
+struct ExternalStats {
+    bool ringIo = false, directIo = false;
+    size_t requests = 0, bytesRead = 0, ramBytes = 0;
+};
+
+class ExternalGraph {
+public:
+    explicit ExternalGraph(const std::string& path, unsigned depth = 64) : depth(depth) {
+        fd = open(path.c_str(), O_RDONLY | O_DIRECT);
+        directIo = fd >= 0;
+        if (fd < 0) fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+
+        AlignedBuffer header = allocateAligned(BLOCK);
+        if (pread(fd, header.get(), BLOCK, 0) != static_cast<ssize_t>(BLOCK)) throw std::runtime_error("cannot read header");
+        uint64_t fields[3];
+        std::memcpy(fields, header.get(), sizeof(fields));
+        if (fields[0] != MAGIC) throw std::runtime_error(path + " is not a CSR file");
+        // The file comes from outside: sizes, offsets and (while counting
+        // in-degrees) every target are checked before they index anything
+        if (fields[1] > UINT32_MAX) throw std::runtime_error(path + ": vertex count exceeds 32 bits");
+        n = fields[1];
+        m = fields[2];
+        struct stat info;
+        if (fstat(fd, &info) != 0 || m > (UINT64_MAX - BLOCK) / 4 ||
+            static_cast<uint64_t>(info.st_size) < BLOCK + alignUp(8 * (n + 1)) + alignUp(4 * m)) {
+            throw std::runtime_error(path + " is shorter than its header claims");
+        }
+
+        uint64_t offsetBytes = alignUp(8 * (n + 1));
+        AlignedBuffer raw = allocateAligned(offsetBytes);
+        for (uint64_t done = 0; done < offsetBytes;) {
+            ssize_t r = pread(fd, raw.get() + done, std::min<uint64_t>(offsetBytes - done, 1 << 26), BLOCK + done);
+            if (r <= 0) throw std::runtime_error("cannot read offsets");
+            done += r;
+        }
+        offsets.resize(n + 1);
+        std::memcpy(offsets.data(), raw.get(), 8 * (n + 1));
+        if (offsets[0] != 0 || offsets[n] != m) throw std::runtime_error(path + ": offsets do not span the edges");
+        for (uint32_t v = 0; v < n; ++v) {
+            if (offsets[v] > offsets[v + 1]) throw std::runtime_error(path + ": offsets decrease at vertex " + std::to_string(v));
+        }
+        targetsBase = BLOCK + offsetBytes;
+    }
+
+    ~ExternalGraph() { close(fd); }
+
+    uint32_t numVertices() const { return n; }
+    uint64_t numEdges() const { return m; }
+
+    std::vector<uint32_t> detectCycle(ExternalStats& stats) {
+        AsyncReader reader(fd, depth);
+        std::vector<uint32_t> inDegree = countInDegrees(reader);
+        std::vector<uint32_t> cycle;
+        if (!kahn(reader, inDegree)) cycle = findCycle(reader, inDegree);
+
+        stats.ringIo = reader.usesRing();
+        stats.directIo = directIo;
+        stats.requests = reader.requests;
+        stats.bytesRead = reader.bytesRead;
+        // Offsets, in-degrees, DFS colors, plus the peak of the phase buffers
+        // (in-degree chunks, Kahn block cache, DFS stack and list caches)
+        stats.ramBytes = offsets.size() * 8 + inDegree.size() * 4 + n + bufferPeakBytes;
+        return cycle;
+    }
+
+private:
+    // One read covering the adjacency lists of `vertices` (sorted by id)
+    struct Request {
+        std::vector<uint32_t> vertices;
+        uint64_t blockStart, blockEnd;
+        AlignedBuffer buffer;
+    };
+
+    Request readLists(AsyncReader& reader, std::vector<uint32_t> vertices, uint64_t tag) {
+        Request r = readEdges(reader, offsets[vertices.front()], offsets[vertices.back() + 1], tag);
+        r.vertices = std::move(vertices);
+        return r;
+    }
+
+    // One read covering edges [first, end) of the targets section
+    Request readEdges(AsyncReader& reader, uint64_t first, uint64_t end, uint64_t tag) {
+        Request r{{}, alignDown(targetsBase + 4 * first), alignUp(targetsBase + 4 * end), nullptr};
+        uint64_t bytes = r.blockEnd - r.blockStart;
+        r.buffer = allocateAligned(bytes);
+        reader.enqueue(r.blockStart, bytes, r.buffer.get(), tag);
+        return r;
+    }
+
+    template <class F>
+    void forEachTarget(const Request& r, uint32_t v, F f) const {
+        const uint8_t* base = r.buffer.get() + (targetsBase + 4 * offsets[v] - r.blockStart);
+        for (uint64_t i = 0; i < offsets[v + 1] - offsets[v]; ++i) {
+            uint32_t t;
+            std::memcpy(&t, base + 4 * i, 4);
+            f(t);
+        }
+    }
+
+    // The targets section is streamed through a fixed set of chunk buffers,
+    // one per read in flight, allocated once so the heap does not fragment
+    std::vector<uint32_t> countInDegrees(AsyncReader& reader) {
+        const uint64_t chunk = 8 << 20;
+        uint64_t totalBytes = alignUp(4 * m);
+        unsigned inFlightLimit = std::min(depth, 4u);
+        std::vector<AlignedBuffer> buffers;
+        for (unsigned i = 0; i < inFlightLimit; ++i) buffers.push_back(allocateAligned(chunk));
+        bufferPeakBytes = std::max<size_t>(bufferPeakBytes, inFlightLimit * chunk);
+        std::vector<uint64_t> chunkStart(inFlightLimit);
+        std::vector<unsigned> freeSlots;
+        for (unsigned i = 0; i < inFlightLimit; ++i) freeSlots.push_back(i);
+        std::vector<uint32_t> inDegree(n, 0);
+        uint64_t next = 0;
+        while (next < totalBytes || reader.pending() > 0) {
+            while (next < totalBytes && !freeSlots.empty()) {
+                unsigned slot = freeSlots.back();
+                freeSlots.pop_back();
+                uint64_t bytes = std::min(chunk, totalBytes - next);
+                chunkStart[slot] = next;
+                reader.enqueue(targetsBase + next, bytes, buffers[slot].get(), slot);
+                next += bytes;
+            }
+            uint64_t slot = reader.waitOne();
+            uint64_t firstEdge = chunkStart[slot] / 4;
+            uint64_t count = std::min<uint64_t>(m - firstEdge, std::min(chunk, totalBytes - chunkStart[slot]) / 4);
+            const uint8_t* data = buffers[slot].get();
+            for (uint64_t i = 0; i < count; ++i) {
+                uint32_t t;
+                std::memcpy(&t, data + 4 * i, 4);
+                if (t >= n) throw std::runtime_error("edge target " + std::to_string(t) + " out of range");
+                inDegree[t]++;
+            }
+            freeSlots.push_back(slot);
+        }
+        return inDegree;
+    }
+
+    // Returns true if every vertex was removed (the graph is acyclic).
+    // Ready vertices are processed in sweeps over the file in id order: a
+    // vertex that becomes ready ahead of the read cursor joins the current
+    // sweep, one behind it waits for the next. Lists of ready vertices close
+    // together on disk are coalesced into one read, as long as the read
+    // fetches at most MAX_WASTED_BYTES beyond its lists (gaps and block
+    // padding). Finished reads stay in a FIFO cache of KAHN_CACHE_BYTES, so
+    // vertices that become ready just behind the frontier of a sweep find
+    // their block still in memory. A block is thus read about once per sweep
+    // instead of once per Kahn level, and a DAG whose edges mostly point
+    // forward in id order is done in a few sweeps.
+    bool kahn(AsyncReader& reader, std::vector<uint32_t>& inDegree) {
+        const uint64_t MAX_WASTED_BYTES = 16 << 10, MAX_READ_BYTES = 4 << 20, KAHN_CACHE_BYTES = 32 << 20;
+        std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ahead;
+        std::vector<uint32_t> behind;
+        for (uint32_t v = 0; v < n; ++v) {
+            if (inDegree[v] == 0) ahead.push(v);
+        }
+        uint32_t cursor = 0; // first vertex after the last issued read
+        size_t removed = 0;
+        std::unordered_map<uint64_t, Request> requests;
+        uint64_t nextTag = 0;
+        auto release = [&](const Request& r, uint32_t v) {
+            forEachTarget(r, v, [&](uint32_t t) {
+                if (--inDegree[t] > 0) return;
+                if (t >= cursor) {
+                    ahead.push(t);
+                } else {
+                    behind.push_back(t);
+                }
+            });
+        };
+
+        std::map<uint64_t, Request> cache; // by first byte
+        std::deque<uint64_t> cacheOrder;
+        uint64_t cacheBytes = 0;
+        auto cached = [&](uint32_t v) -> const Request* {
+            uint64_t begin = targetsBase + 4 * offsets[v], end = targetsBase + 4 * offsets[v + 1];
+            auto it = cache.upper_bound(begin);
+            if (it == cache.begin()) return nullptr;
+            --it;
+            return end <= it->second.blockEnd ? &it->second : nullptr;
+        };
+        auto complete = [&]() {
+            auto it = requests.find(reader.waitOne());
+            for (uint32_t v : it->second.vertices) release(it->second, v);
+            uint64_t key = it->second.blockStart, bytes = it->second.blockEnd - key;
+            if (!cache.count(key)) {
+                while (!cacheOrder.empty() && cacheBytes + bytes > KAHN_CACHE_BYTES) {
+                    auto old = cache.find(cacheOrder.front());
+                    cacheBytes -= old->second.blockEnd - old->second.blockStart;
+                    cache.erase(old);
+                    cacheOrder.pop_front();
+                }
+                cacheBytes += bytes;
+                cacheOrder.push_back(key);
+                cache.emplace(key, std::move(it->second));
+                bufferPeakBytes = std::max<size_t>(bufferPeakBytes, cacheBytes);
+            }
+            requests.erase(it);
+        };
+        auto readBytes = [&](uint32_t first, uint32_t last) {
+            return alignUp(targetsBase + 4 * offsets[last + 1]) - alignDown(targetsBase + 4 * offsets[first]);
+        };
+        while (true) {
+            while (!ahead.empty() && !reader.full()) {
+                std::vector<uint32_t> group;
+                uint64_t listBytes = 0;
+                while (!ahead.empty()) {
+                    uint32_t v = ahead.top();
+                    uint64_t bytes = 4 * (offsets[v + 1] - offsets[v]);
+                    if (!group.empty() && bytes > 0) {
+                        uint64_t span = readBytes(group.front(), v);
+                        if (span > MAX_READ_BYTES || span - listBytes - bytes > MAX_WASTED_BYTES) break;
+                    }
+                    ahead.pop();
+                    removed++;
+                    cursor = v + 1;
+                    if (bytes == 0) continue;
+                    if (const Request* r = cached(v)) {
+                        release(*r, v);
+                        continue;
+                    }
+                    group.push_back(v);
+                    listBytes += bytes;
+                }
+                if (group.empty()) continue;
+                requests.emplace(nextTag, readLists(reader, std::move(group), nextTag));
+                nextTag++;
+            }
+            if (reader.pending() > 0) {
+                complete();
+            } else if (ahead.empty()) {
+                if (behind.empty()) break;
+                for (uint32_t v : behind) ahead.push(v);
+                behind.clear();
+                cursor = 0;
+            }
+        }
+        return removed == n;
+    }
+
+    // Semi-external DFS over the vertices Kahn could not remove. A frame is
+    // only (vertex, edge cursor); the edges are read back when the frame is
+    // on top. The top frame's edges are held in one chunk of at most
+    // DFS_CHUNK_EDGES, refilled from disk when the cursor leaves it, and lists
+    // prefetched for upcoming frames share a fixed byte budget, so memory
+    // stays O(V) however long the lists on the stack are.
+    std::vector<uint32_t> findCycle(AsyncReader& reader, const std::vector<uint32_t>& inDegree) {
+        const uint64_t DFS_CHUNK_EDGES = 1 << 18, PREFETCH_BUDGET_BYTES = 16 << 20, STACK_CACHE_BYTES = 16 << 20;
+        const uint64_t SYNC_TAG = UINT64_MAX;
+        std::vector<uint8_t> state(n, 0); // 0 = unvisited, 1 = on stack, 2 = done
+        std::unordered_map<uint64_t, Request> inFlight; // tag = vertex
+        std::unordered_map<uint32_t, std::vector<uint32_t>> ready;
+        uint64_t budgetUsed = 0; // bytes of lists in flight or ready
+        // Heap bytes of a cached list: its edges plus map node and vector header
+        auto footprint = [](uint64_t edges) { return 4 * edges + 64; };
+
+        auto complete = [&](uint64_t tag) {
+            auto it = inFlight.find(tag);
+            uint32_t v = it->second.vertices[0];
+            std::vector<uint32_t>& list = ready[v];
+            forEachTarget(it->second, v, [&](uint32_t t) { list.push_back(t); });
+            inFlight.erase(it);
+        };
+        auto prefetch = [&](uint32_t v) {
+            uint64_t edges = offsets[v + 1] - offsets[v], bytes = footprint(edges);
+            if (edges == 0 || edges > DFS_CHUNK_EDGES || budgetUsed + bytes > PREFETCH_BUDGET_BYTES) return;
+            if (ready.count(v) || inFlight.count(v) || reader.full()) return;
+            inFlight.emplace(v, readLists(reader, {v}, v));
+            budgetUsed += bytes;
+        };
+        // Edges [from, from + DFS_CHUNK_EDGES) of v's list: from the chunks
+        // parked when a frame went below the top, from a prefetched list, or
+        // else with a read of just that range. Parked chunks share a budget
+        // of STACK_CACHE_BYTES; the oldest, i.e. the shallowest, go first.
+        std::vector<uint32_t> chunk;
+        uint32_t chunkVertex = UINT32_MAX;
+        uint64_t chunkFirst = 0;
+        std::unordered_map<uint32_t, std::pair<uint64_t, std::vector<uint32_t>>> parked;
+        std::deque<uint32_t> parkedOrder;
+        uint64_t parkedBytes = 0;
+        auto load = [&](uint32_t v, uint64_t from) {
+            if (chunkVertex != UINT32_MAX && state[chunkVertex] == 1 && footprint(chunk.size()) <= STACK_CACHE_BYTES) {
+                while (parkedBytes + footprint(chunk.size()) > STACK_CACHE_BYTES) {
+                    auto old = parked.find(parkedOrder.front());
+                    parkedOrder.pop_front();
+                    if (old == parked.end()) continue;
+                    parkedBytes -= footprint(old->second.second.size());
+                    parked.erase(old);
+                }
+                parkedBytes += footprint(chunk.size());
+                parkedOrder.push_back(chunkVertex);
+                parked[chunkVertex] = {chunkFirst, std::move(chunk)};
+            }
+            chunkVertex = v;
+            chunkFirst = from;
+            auto p = parked.find(v);
+            if (p != parked.end()) {
+                parkedBytes -= footprint(p->second.second.size());
+                bool covers = from >= p->second.first && from < p->second.first + p->second.second.size();
+                if (covers) {
+                    chunkFirst = p->second.first;
+                    chunk = std::move(p->second.second);
+                }
+                parked.erase(p);
+                if (covers) return;
+            }
+            if (from == 0 && inFlight.count(v)) {
+                while (!ready.count(v)) complete(reader.waitOne());
+            }
+            auto it = ready.find(v);
+            if (from == 0 && it != ready.end()) {
+                budgetUsed -= footprint(it->second.size());
+                chunk = std::move(it->second);
+                ready.erase(it);
+                return;
+            }
+            uint64_t first = offsets[v] + from, end = std::min(offsets[v + 1], first + DFS_CHUNK_EDGES);
+            while (reader.full()) complete(reader.waitOne());
+            Request r = readEdges(reader, first, end, SYNC_TAG);
+            for (uint64_t tag; (tag = reader.waitOne()) != SYNC_TAG;) complete(tag);
+            chunk.resize(end - first);
+            std::memcpy(chunk.data(), r.buffer.get() + (targetsBase + 4 * first - r.blockStart), 4 * chunk.size());
+        };
+
+        struct Frame {
+            uint32_t vertex;
+            uint64_t next;
+        };
+        std::vector<Frame> stack;
+        auto enter = [&](uint32_t v) {
+            state[v] = 1;
+            stack.push_back({v, 0});
+            load(v, 0);
+            bufferPeakBytes = std::max<size_t>(bufferPeakBytes, stack.size() * sizeof(Frame) + 4 * chunk.capacity() + budgetUsed + parkedBytes);
+            for (uint32_t t : chunk) {
+                if (state[t] == 0 && inDegree[t] > 0) prefetch(t);
+            }
+        };
+        for (uint32_t root = 0; root < n; ++root) {
+            if (inDegree[root] == 0 || state[root] != 0) continue;
+            enter(root);
+            while (!stack.empty()) {
+                Frame& top = stack.back();
+                if (top.next == offsets[top.vertex + 1] - offsets[top.vertex]) {
+                    state[top.vertex] = 2;
+                    stack.pop_back();
+                    continue;
+                }
+                if (chunkVertex != top.vertex || top.next < chunkFirst || top.next >= chunkFirst + chunk.size()) {
+                    load(top.vertex, top.next);
+                }
+                uint32_t v = chunk[top.next++ - chunkFirst];
+                if (inDegree[v] == 0) continue; // removed by Kahn
+                if (state[v] == 1) {
+                    while (reader.pending() > 0) reader.waitOne();
+                    size_t k = stack.size();
+                    while (stack[k - 1].vertex != v) --k;
+                    std::vector<uint32_t> cycle;
+                    for (size_t i = k - 1; i < stack.size(); ++i) cycle.push_back(stack[i].vertex);
+                    return cycle;
+                }
+                if (state[v] == 0) enter(v);
+            }
+        }
+        while (reader.pending() > 0) reader.waitOne();
+        return {};
+    }
+
+    int fd;
+    bool directIo = false;
+    unsigned depth;
+    uint32_t n;
+    uint64_t m;
+    uint64_t targetsBase;
+    std::vector<uint64_t> offsets;
+    size_t bufferPeakBytes = 0;
+};
+
+void printCycle(const std::vector<uint32_t>& cycle) {
+    if (cycle.empty()) {
+        std::cout << "Result: Graph is ACYCLIC." << std::endl;
+        return;
+    }
+    std::cout << "Result: Graph is CYCLIC. Vertices in a cycle: ";
+    for (uint32_t v : cycle) std::cout << v << " -> ";
+    std::cout << cycle[0] << std::endl;
+}
+
+void printStats(const ExternalStats& stats) {
+    std::cout << "I/O: " << (stats.ringIo ? "io_uring" : "pread") << (stats.directIo ? ", O_DIRECT" : ", buffered")
+              << ", " << stats.requests << " reads, " << (stats.bytesRead >> 20) << " MB read, vertex state in RAM: "
+              << (stats.ramBytes >> 20) << " MB" << std::endl;
+}
+
+int main() {
+    std::cout << "--- Out-of-Core Cycle Detection (Disk CSR, io_uring) ---" << std::endl;
+    std::string dir = std::filesystem::temp_directory_path().string();
+
+    try {
+        // Example: the 4-vertex test case written to disk
+        std::cout << "\n--- Test Case: Cyclic Graph ---" << std::endl;
+        std::string smallPath = dir + "/cyclic_external_small.csr";
+        std::vector<std::vector<uint32_t>> adj = {{1}, {2, 3}, {}, {1}};
+        writeDiskCSR(smallPath, 4, [&](uint32_t v) { return adj[v].size(); },
+                     [&](uint32_t v, std::vector<uint32_t>& out) { out = adj[v]; });
+        {
+            ExternalGraph small(smallPath);
+            ExternalStats stats;
+            printCycle(small.detectCycle(stats));
+        }
+
+        // Example: corrupt copies of the same file are rejected: a target
+        // out of range, decreasing offsets, and offsets not ending at m
+        std::cout << "\n--- Test Case: Corrupt Files ---" << std::endl;
+        auto patch = [&](uint64_t position, uint64_t value, int bytes) {
+            writeDiskCSR(smallPath, 4, [&](uint32_t v) { return adj[v].size(); },
+                         [&](uint32_t v, std::vector<uint32_t>& out) { out = adj[v]; });
+            FILE* f = std::fopen(smallPath.c_str(), "r+b");
+            std::fseek(f, position, SEEK_SET);
+            std::fwrite(&value, bytes, 1, f);
+            std::fclose(f);
+        };
+        uint64_t targetsAt = BLOCK + alignUp(8 * 5);
+        for (int corruption = 0; corruption < 3; ++corruption) {
+            if (corruption == 0) patch(targetsAt + 4, 99, 4);  // second edge points to vertex 99
+            if (corruption == 1) patch(BLOCK + 8 * 2, 5, 8);   // offsets[2] > offsets[3]
+            if (corruption == 2) patch(BLOCK + 8 * 4, 3, 8);   // offsets[4] != m
+            try {
+                ExternalGraph corrupt(smallPath);
+                ExternalStats stats;
+                printCycle(corrupt.detectCycle(stats));
+            } catch (const std::runtime_error& e) {
+                std::cout << "Rejected: " << e.what() << std::endl;
+            }
+        }
+        std::filesystem::remove(smallPath);
+
+        // Throughput: 8M vertices, 8 forward edges each within a window of
+        // 65536, plus one back edge closing a cycle through the upper half
+        std::cout << "\n--- Throughput: 8M Vertices, 64M Edges on Disk ---" << std::endl;
+        const uint32_t n = 1 << 23, perVertex = 8, window = 1 << 16;
+        auto target = [&](uint32_t v, uint32_t k) {
+            uint64_t h = (static_cast<uint64_t>(v) << 8 | k) * 0x9e3779b97f4a7c15ULL;
+            return v + 1 + static_cast<uint32_t>((h >> 40) % window);
+        };
+        auto degree = [&](uint32_t v) {
+            uint32_t d = 0;
+            for (uint32_t k = 0; k < perVertex; ++k) d += target(v, k) < n;
+            return d + (v == n - 1);
+        };
+        auto neighbors = [&](uint32_t v, std::vector<uint32_t>& out) {
+            for (uint32_t k = 0; k < perVertex; ++k) {
+                if (target(v, k) < n) out.push_back(target(v, k));
+            }
+            if (v == n - 1) out.push_back(n / 2);
+        };
+
+        std::string path = dir + "/cyclic_external.csr";
+        auto start = std::chrono::steady_clock::now();
+        writeDiskCSR(path, n, degree, neighbors);
+        double writeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "File: " << (std::filesystem::file_size(path) >> 20) << " MB, written in " << writeSeconds << " s"
+                  << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        ExternalGraph big(path);
+        ExternalStats stats;
+        std::vector<uint32_t> cycle = big.detectCycle(stats);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Edges: " << big.numEdges() << ", detection: " << seconds << " s, cycle length " << cycle.size()
+                  << std::endl;
+        printStats(stats);
+        std::filesystem::remove(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,334 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <linux/perf_event.h>
+#include <unistd.h>
+
+// Huge-page backed graph and workspace arrays for large graphs.
+//
+// With hundreds of millions of vertices, every `inDegree[v]--` in Kahn's
+// loop and every `visited[v]` / `recStack[v]` check in the DFS lands on a
+// random 4 KB page; the dTLB covers a few MB, so most of those accesses
+// also pay a page walk. Backing the arrays with 2 MB (or 1 GB) pages
+// covers them with a few hundred TLB entries.
+//
+// PagedArray maps its memory with one of:
+//   - SMALL:      4 KB pages (transparent huge pages disabled for the range),
+//   - THP:        2 MB-aligned mapping with madvise(MADV_HUGEPAGE),
+//   - HUGETLB_2M / HUGETLB_1G: explicit hugetlbfs pages (MAP_HUGETLB); these
+//     need a reserved pool (vm.nr_hugepages), and the array falls back to
+//     THP when the pool cannot serve it.
+// The pages are prefaulted by several threads, each touching one byte per
+// page of its chunk, so the page faults (and the kernel's zeroing / huge-page
+// compaction) are paid up front and in parallel instead of inside the
+// traversal. The backing actually obtained is read back from
+// /proc/self/smaps, and the traversals are measured with the dTLB read-miss
+// counter (perf_event_open) when the machine exposes it.
+
+enum class PageMode { SMALL, THP, HUGETLB_2M, HUGETLB_1G };
+
+const char* pageModeName(PageMode m) {
+    switch (m) {
+        case PageMode::SMALL: return "4K pages";
+        case PageMode::THP: return "THP (madvise)";
+        case PageMode::HUGETLB_2M: return "hugetlb 2M";
+        default: return "hugetlb 1G";
+    }
+}
+
+unsigned numThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+template <typename T>
+class PagedArray {
+public:
+    static_assert(std::is_trivially_destructible<T>::value, "PagedArray does not run destructors");
+
+    PagedArray(size_t n, PageMode requested, unsigned prefaultThreads = numThreads()) : n(n), mode(requested) {
+        size_t need = std::max<size_t>(1, n * sizeof(T));
+        if (mode == PageMode::HUGETLB_2M || mode == PageMode::HUGETLB_1G) {
+            int shift = mode == PageMode::HUGETLB_2M ? 21 : 30;
+            pageBytes = size_t(1) << shift;
+            bytes = (need + pageBytes - 1) / pageBytes * pageBytes;
+            base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (shift << MAP_HUGE_SHIFT), -1, 0);
+            if (base == MAP_FAILED) mode = PageMode::THP; // no pool reserved
+        }
+        if (mode == PageMode::THP) {
+            // Over-map, then trim to a 2 MB-aligned range so every 2 MB
+            // stretch of the array can become one huge page
+            pageBytes = HUGE_2M;
+            bytes = (need + HUGE_2M - 1) / HUGE_2M * HUGE_2M;
+            char* raw = static_cast<char*>(
+                mmap(nullptr, bytes + HUGE_2M, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+            if (raw == MAP_FAILED) throw std::runtime_error("mmap failed");
+            char* aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(raw) + HUGE_2M - 1) & ~(HUGE_2M - 1));
+            if (aligned > raw) munmap(raw, aligned - raw);
+            munmap(aligned + bytes, raw + HUGE_2M - aligned);
+            base = aligned;
+            madvise(base, bytes, MADV_HUGEPAGE);
+        } else if (mode == PageMode::SMALL) {
+            pageBytes = 4096;
+            bytes = (need + 4095) / 4096 * 4096;
+            base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base == MAP_FAILED) throw std::runtime_error("mmap failed");
+            madvise(base, bytes, MADV_NOHUGEPAGE);
+        }
+        prefault(prefaultThreads);
+    }
+    PagedArray(const PagedArray&) = delete;
+    PagedArray& operator=(const PagedArray&) = delete;
+    ~PagedArray() { munmap(base, bytes); }
+
+    T& operator[](size_t i) { return static_cast<T*>(base)[i]; }
+    const T& operator[](size_t i) const { return static_cast<const T*>(base)[i]; }
+    size_t size() const { return n; }
+    PageMode pageMode() const { return mode; }
+
+    // Bytes of the mapping the kernel backs with huge pages right now
+    size_t hugeBytes() const {
+        std::ifstream smaps("/proc/self/smaps");
+        std::string line;
+        bool inside = false;
+        uintptr_t start = reinterpret_cast<uintptr_t>(base);
+        while (std::getline(smaps, line)) {
+            // Mapping headers start with "lo-hi ", attribute lines with "Name:"
+            if (line.find('-') < line.find(' ')) {
+                uintptr_t lo, hi;
+                char dash;
+                std::istringstream header(line);
+                header >> std::hex >> lo >> dash >> hi;
+                inside = lo <= start && start < hi;
+                continue;
+            }
+            if (!inside) continue;
+            size_t kb;
+            if (std::sscanf(line.c_str(), "AnonHugePages: %zu kB", &kb) == 1 && kb > 0) return kb << 10;
+            if (std::sscanf(line.c_str(), "KernelPageSize: %zu kB", &kb) == 1 && kb >= 2048) return bytes;
+        }
+        return 0;
+    }
+
+private:
+    static constexpr size_t HUGE_2M = size_t(1) << 21;
+
+    void prefault(unsigned threads) {
+        size_t pages = bytes / pageBytes;
+        threads = std::max<size_t>(1, std::min<size_t>(threads, pages));
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                volatile char* p = static_cast<char*>(base);
+                for (size_t page = pages * t / threads; page < pages * (t + 1) / threads; ++page) p[page * pageBytes] = 0;
+            });
+        }
+        for (auto& th : pool) th.join();
+    }
+
+    size_t n, bytes = 0, pageBytes = 4096;
+    void* base = MAP_FAILED;
+    PageMode mode;
+};
+
+// Counts events of the calling thread between start() and stop(); value()
+// is -1 when the machine does not expose the counter (e.g. in many VMs)
+class PerfCounter {
+public:
+    PerfCounter(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+    ~PerfCounter() {
+        if (fd >= 0) close(fd);
+    }
+    static PerfCounter dtlbReadMisses() {
+        return PerfCounter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    }
+    static PerfCounter pageFaults() { return PerfCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS); }
+
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    void stop() {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    long long value() const {
+        long long count;
+        if (fd < 0 || read(fd, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+// CSR and per-vertex workspace, all in PagedArrays of one page mode
+struct PagedGraph {
+    PagedArray<uint32_t> offsets, targets;
+
+    PagedGraph(uint32_t n, size_t m, PageMode mode) : offsets(n + 1, mode), targets(m, mode) {}
+    uint32_t numVertices() const { return offsets.size() - 1; }
+};
+
+// Kahn's algorithm; returns the number of vertices removed. The queue
+// holds each vertex at most once, so it is a workspace array of n entries.
+uint32_t kahnRemoved(const PagedGraph& g, PagedArray<uint32_t>& inDegree, PagedArray<uint32_t>& queue) {
+    uint32_t n = g.numVertices();
+    for (uint32_t v = 0; v < n; ++v) inDegree[v] = 0;
+    for (size_t i = 0; i < g.targets.size(); ++i) inDegree[g.targets[i]]++;
+    uint32_t tail = 0;
+    for (uint32_t v = 0; v < n; ++v) {
+        if (inDegree[v] == 0) queue[tail++] = v;
+    }
+    for (uint32_t head = 0; head < tail; ++head) {
+        uint32_t u = queue[head];
+        for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            if (--inDegree[g.targets[i]] == 0) queue[tail++] = g.targets[i];
+        }
+    }
+    return tail;
+}
+
+// Iterative DFS with `visited` / `recStack` flags; returns a cycle or {}
+std::vector<uint32_t> dfsCycle(const PagedGraph& g, PagedArray<uint8_t>& visited, PagedArray<uint8_t>& recStack) {
+    uint32_t n = g.numVertices();
+    for (uint32_t v = 0; v < n; ++v) visited[v] = recStack[v] = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // (vertex, next edge)
+    for (uint32_t root = 0; root < n; ++root) {
+        if (visited[root]) continue;
+        visited[root] = recStack[root] = 1;
+        stack.push_back({root, g.offsets[root]});
+        while (!stack.empty()) {
+            auto& [u, next] = stack.back();
+            if (next == g.offsets[u + 1]) {
+                recStack[u] = 0;
+                stack.pop_back();
+                continue;
+            }
+            uint32_t v = g.targets[next++];
+            if (recStack[v]) {
+                size_t k = stack.size();
+                while (stack[k - 1].first != v) --k;
+                std::vector<uint32_t> cycle;
+                for (size_t i = k - 1; i < stack.size(); ++i) cycle.push_back(stack[i].first);
+                return cycle;
+            }
+            if (!visited[v]) {
+                visited[v] = recStack[v] = 1;
+                stack.push_back({v, g.offsets[v]});
+            }
+        }
+    }
+    return {};
+}
+
+void printCycle(const std::vector<uint32_t>& cycle) {
+    if (cycle.empty()) {
+        std::cout << "Result: Graph is ACYCLIC." << std::endl;
+        return;
+    }
+    std::cout << "Result: Graph is CYCLIC. Vertices in a cycle: ";
+    for (uint32_t v : cycle) std::cout << v << " -> ";
+    std::cout << cycle[0] << std::endl;
+}
+
+std::string counterText(long long value) {
+    return value < 0 ? "n/a" : std::to_string(value);
+}
+
+int main() {
+    std::cout << "--- Huge-Page Backed Graph Arrays ---" << std::endl;
+
+    try {
+        // Example: the 4-vertex test case on THP-backed arrays
+        std::cout << "\n--- Test Case: Cyclic Graph ---" << std::endl;
+        PagedGraph small(4, 4, PageMode::THP);
+        uint32_t offsets[] = {0, 1, 3, 3, 4}, targets[] = {1, 2, 3, 1};
+        for (int i = 0; i < 5; ++i) small.offsets[i] = offsets[i];
+        for (int i = 0; i < 4; ++i) small.targets[i] = targets[i];
+        PagedArray<uint8_t> smallVisited(4, PageMode::THP), smallRecStack(4, PageMode::THP);
+        printCycle(dfsCycle(small, smallVisited, smallRecStack));
+
+        // Throughput: 16M vertices, 64M edges to random later vertices, so
+        // nearly every access to the per-vertex arrays is to another page
+        std::cout << "\n--- Throughput: 16M Vertices, 64M Random Forward Edges ---" << std::endl;
+        const uint32_t n = 1 << 24, degree = 4;
+        for (PageMode requested : {PageMode::SMALL, PageMode::THP, PageMode::HUGETLB_2M, PageMode::HUGETLB_1G}) {
+            auto start = std::chrono::steady_clock::now();
+            PagedGraph g(n, static_cast<size_t>(n - 1) * degree, requested);
+            PagedArray<uint32_t> inDegree(n, requested), queue(n, requested);
+            PagedArray<uint8_t> visited(n, requested), recStack(n, requested);
+            double allocSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            for (uint32_t u = 0; u < n; ++u) {
+                g.offsets[u] = u * degree;
+                if (u + 1 == n) break;
+                for (uint32_t k = 0; k < degree; ++k) {
+                    uint64_t h = (static_cast<uint64_t>(u) * degree + k + 1) * 0x9e3779b97f4a7c15ULL;
+                    g.targets[static_cast<size_t>(u) * degree + k] = u + 1 + (h >> 32) % (n - u - 1);
+                }
+            }
+            g.offsets[n] = g.targets.size();
+
+            std::cout << pageModeName(requested);
+            if (g.targets.pageMode() != requested) std::cout << " (no pool, fell back to " << pageModeName(g.targets.pageMode()) << ")";
+            size_t total = (g.offsets.size() + g.targets.size() + inDegree.size() + queue.size()) * 4 + 2 * static_cast<size_t>(n);
+            size_t huge = g.offsets.hugeBytes() + g.targets.hugeBytes() + inDegree.hugeBytes() + queue.hugeBytes() +
+                          visited.hugeBytes() + recStack.hugeBytes();
+            std::cout << ": " << (total >> 20) << " MB of arrays, " << (huge >> 20) << " MB on huge pages, allocation + "
+                      << "prefault " << allocSeconds << " s" << std::endl;
+
+            PerfCounter tlb = PerfCounter::dtlbReadMisses(), faults = PerfCounter::pageFaults();
+            tlb.start();
+            faults.start();
+            start = std::chrono::steady_clock::now();
+            uint32_t removed = kahnRemoved(g, inDegree, queue);
+            double kahnSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            tlb.stop();
+            faults.stop();
+            std::cout << "  Kahn: " << kahnSeconds << " s (" << (removed == n ? "acyclic" : "cyclic")
+                      << "), dTLB misses: " << counterText(tlb.value()) << ", page faults: " << counterText(faults.value())
+                      << std::endl;
+
+            tlb.start();
+            faults.start();
+            start = std::chrono::steady_clock::now();
+            std::vector<uint32_t> cycle = dfsCycle(g, visited, recStack);
+            double dfsSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            tlb.stop();
+            faults.stop();
+            std::cout << "  DFS:  " << dfsSeconds << " s (" << (cycle.empty() ? "acyclic" : "cyclic")
+                      << "), dTLB misses: " << counterText(tlb.value()) << ", page faults: " << counterText(faults.value())
+                      << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,869 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+#include <unordered_set>
+#include <algorithm>
+
+// Cycle detection on implicitly defined graphs (state spaces generated on the fly).
+//
+// The DFS and Kahn/BFS engines are templated over a successor generator
+// instead of taking an adjacency matrix. A generator must provide
+//   using State = ...;                                   // copyable, ==
+//   std::vector<State> initialStates() const;
+//   template <class F> void forEachSuccessor(const State& s, F f) const;
+// Only states reachable from the initial states are ever created. Visited
+// states live in an open-addressing hash table that hands out dense ids, so
+// per-state bookkeeping is a byte or a counter instead of matrix rows.
+
+template <typename State, typename Hash = std::hash<State>>
+class StateTable {
+public:
+    explicit StateTable(size_t initialCapacity = 1 << 16) {
+        size_t cap = 16;
+        while (cap < initialCapacity) cap <<= 1;
+        slots.assign(cap, EMPTY);
+    }
+
+    // Returns {id, inserted}. Ids are dense and stable.
+    std::pair<uint32_t, bool> insert(const State& s) {
+        if ((states.size() + 1) * 4 > slots.size() * 3) rehash();
+        size_t mask = slots.size() - 1;
+        for (size_t i = mix(hasher(s)) & mask;; i = (i + 1) & mask) {
+            if (slots[i] == EMPTY) {
+                slots[i] = states.size();
+                states.push_back(s);
+                return {slots[i], true};
+            }
+            if (states[slots[i]] == s) return {slots[i], false};
+        }
+    }
+
+    // Id of a state that is known to be in the table.
+    uint32_t find(const State& s) const {
+        size_t mask = slots.size() - 1;
+        size_t i = mix(hasher(s)) & mask;
+        while (!(states[slots[i]] == s)) i = (i + 1) & mask;
+        return slots[i];
+    }
+
+    // Id of a state, or NOT_FOUND if it was never inserted.
+    uint32_t lookup(const State& s) const {
+        size_t mask = slots.size() - 1;
+        for (size_t i = mix(hasher(s)) & mask;; i = (i + 1) & mask) {
+            if (slots[i] == EMPTY) return NOT_FOUND;
+            if (states[slots[i]] == s) return slots[i];
+        }
+    }
+
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    const State& state(uint32_t id) const { return states[id]; }
+    size_t size() const { return states.size(); }
+    size_t memoryBytes() const { return slots.size() * sizeof(uint32_t) + states.capacity() * sizeof(State); }
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    static size_t mix(size_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    void rehash() {
+        std::vector<uint32_t> old(slots.size() * 2, EMPTY);
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (uint32_t id = 0; id < states.size(); ++id) {
+            size_t i = mix(hasher(states[id])) & mask;
+            while (slots[i] != EMPTY) i = (i + 1) & mask;
+            slots[i] = id;
+        }
+    }
+
+    std::vector<uint32_t> slots;
+    std::vector<State> states;
+    Hash hasher;
+};
+
+template <typename Generator>
+struct ImplicitResult {
+    bool cyclic = false;
+    std::vector<typename Generator::State> cycle; // witness, first state repeated implicitly
+    size_t statesExplored = 0;
+    double omissionProbability = 0; // approximate visited sets only
+    bool budgetExhausted = false;
+};
+
+// Iterative DFS with a recursion-stack flag per state (the implicit `recStack`).
+// Successors of every state on the stack are kept in one shared buffer, so
+// memory is proportional to the search depth times the branching factor.
+template <typename Generator>
+ImplicitResult<Generator> isCyclicImplicitDFS(const Generator& gen) {
+    using State = typename Generator::State;
+    ImplicitResult<Generator> result;
+    StateTable<State> table;
+    std::vector<uint8_t> onStack;
+
+    struct Frame {
+        uint32_t id;
+        size_t begin, next, end; // this state's successors in `successors`
+    };
+    std::vector<Frame> stack;
+    std::vector<State> successors;
+
+    auto push = [&](uint32_t id) {
+        onStack[id] = 1;
+        size_t begin = successors.size();
+        gen.forEachSuccessor(table.state(id), [&](const State& t) { successors.push_back(t); });
+        stack.push_back({id, begin, begin, successors.size()});
+    };
+
+    for (const State& init : gen.initialStates()) {
+        auto [rootId, isNew] = table.insert(init);
+        if (!isNew) continue;
+        onStack.push_back(0);
+        push(rootId);
+
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.next == top.end) {
+                onStack[top.id] = 0;
+                successors.resize(top.begin);
+                stack.pop_back();
+                continue;
+            }
+            State t = successors[top.next++];
+            auto [id, inserted] = table.insert(t);
+            if (inserted) {
+                onStack.push_back(0);
+                push(id);
+            } else if (onStack[id]) {
+                // Back edge: the cycle is the stack suffix starting at `id`
+                size_t k = stack.size();
+                while (stack[k - 1].id != id) --k;
+                for (size_t i = k - 1; i < stack.size(); ++i) {
+                    result.cycle.push_back(table.state(stack[i].id));
+                }
+                result.cyclic = true;
+                result.statesExplored = table.size();
+                return result;
+            }
+        }
+    }
+    result.statesExplored = table.size();
+    return result;
+}
+
+// Kahn's algorithm on the reachable state space: one BFS pass numbers the
+// states and counts in-degrees, a second pass peels zero in-degree states,
+// regenerating successors instead of storing edges.
+template <typename Generator>
+ImplicitResult<Generator> detectCycleImplicitBFS(const Generator& gen) {
+    using State = typename Generator::State;
+    ImplicitResult<Generator> result;
+    StateTable<State> table;
+    std::vector<uint32_t> inDegree;
+
+    std::queue<uint32_t> q;
+    for (const State& init : gen.initialStates()) {
+        auto [id, inserted] = table.insert(init);
+        if (inserted) {
+            inDegree.push_back(0);
+            q.push(id);
+        }
+    }
+    while (!q.empty()) {
+        uint32_t u = q.front();
+        q.pop();
+        State s = table.state(u); // inserting below may move the stored states
+        gen.forEachSuccessor(s, [&](const State& t) {
+            auto [id, inserted] = table.insert(t);
+            if (inserted) {
+                inDegree.push_back(0);
+                q.push(id);
+            }
+            inDegree[id]++;
+        });
+    }
+
+    for (uint32_t id = 0; id < table.size(); ++id) {
+        if (inDegree[id] == 0) q.push(id);
+    }
+    size_t processedCount = 0;
+    while (!q.empty()) {
+        uint32_t u = q.front();
+        q.pop();
+        processedCount++;
+        gen.forEachSuccessor(table.state(u), [&](const State& t) {
+            uint32_t id = table.find(t);
+            if (--inDegree[id] == 0) q.push(id);
+        });
+    }
+
+    result.statesExplored = table.size();
+    result.cyclic = processedCount < table.size();
+    if (result.cyclic) {
+        // Every unpeeled state has an unpeeled predecessor; walking backwards
+        // would need predecessor lists, so recover a witness with the DFS engine.
+        result.cycle = isCyclicImplicitDFS(gen).cycle;
+    }
+    return result;
+}
+
+// Probabilistic visited sets for memory-bounded search. Both keep a fixed
+// memory budget and never store states; a state can be wrongly considered
+// visited (and its subtree skipped), but never the other way round, so any
+// cycle found is real while "acyclic" holds only with the reported
+// probability.
+//
+// Bitstate hashing (Holzmann): one bit array, k bit positions per state
+// derived from a 64-bit hash by double hashing.
+class BitstateVisited {
+public:
+    BitstateVisited(size_t budgetBytes, int numHashes)
+        : bits((budgetBytes * 8 + 63) / 64, 0), numBits(bits.size() * 64), k(numHashes) {}
+
+    // True if the state was not seen before (all k bits were clear).
+    bool insert(uint64_t hash) {
+        uint64_t h1 = hash, h2 = (hash >> 32) | 1;
+        bool isNew = false;
+        for (int i = 0; i < k; ++i) {
+            uint64_t bit = (h1 + i * h2) % numBits;
+            uint64_t mask = 1ULL << (bit & 63);
+            if (!(bits[bit >> 6] & mask)) {
+                bits[bit >> 6] |= mask;
+                bitsSet++;
+                isNew = true;
+            }
+        }
+        if (isNew) inserted++;
+        return isNew;
+    }
+
+    // Chance that a state never visited is reported as visited, averaged
+    // over the search: the mean of (fill ratio)^k, with the fill ratio
+    // growing from 0 to its final value. The expected number of omitted
+    // states is this value times the number of states explored.
+    double omissionProbability() const {
+        double fill = static_cast<double>(bitsSet) / numBits;
+        // Mean of fill(t)^k with fill(t) ~ 1 - exp(-k t / m) over t in [0, n]
+        double steps = 64, sum = 0;
+        double lambda = -std::log(1 - std::min(fill, 0.999999));
+        for (int i = 1; i <= steps; ++i) {
+            sum += std::pow(1 - std::exp(-lambda * i / steps), k);
+        }
+        return sum / steps;
+    }
+
+    bool full() const { return false; }
+    size_t memoryBytes() const { return bits.size() * sizeof(uint64_t); }
+
+private:
+    std::vector<uint64_t> bits;
+    uint64_t numBits;
+    int k;
+    uint64_t bitsSet = 0, inserted = 0;
+};
+
+// Hash compaction (Wolper-Leroy): an open-addressing table of 32-bit
+// fingerprints. Two states collide only if they share both slot chain and
+// fingerprint, so omissions are far rarer than with bitstate hashing, but
+// the table fills up and the search stops when the budget is exhausted.
+class HashCompactVisited {
+public:
+    explicit HashCompactVisited(size_t budgetBytes) {
+        size_t cap = 16;
+        while (cap * 2 * sizeof(uint32_t) <= budgetBytes) cap <<= 1; // largest power of two that fits
+        slots.assign(cap, 0);
+    }
+
+    bool insert(uint64_t hash) {
+        uint32_t fingerprint = static_cast<uint32_t>(hash >> 32) | 1; // 0 marks empty
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            if (slots[i] == 0) {
+                slots[i] = fingerprint;
+                stored++;
+                return true;
+            }
+            if (slots[i] == fingerprint) return false;
+        }
+    }
+
+    // A new state is lost if its 31-bit fingerprint matches one of the slots
+    // on its probe path. An unsuccessful linear-probing lookup at load a
+    // inspects about (1 + 1/(1-a)^2) / 2 slots; averaged over the fill from
+    // 0 to the final load that is (1 + 1/(1-a)) / 2 slots per state.
+    double omissionProbability() const {
+        double load = static_cast<double>(stored) / slots.size();
+        return 0.5 * (1 + 1 / (1 - load)) / 2147483648.0;
+    }
+
+    bool full() const { return stored * 4 >= slots.size() * 3; }
+    size_t memoryBytes() const { return slots.size() * sizeof(uint32_t); }
+
+private:
+    std::vector<uint32_t> slots;
+    size_t stored = 0;
+};
+
+// DFS over a probabilistic visited set. States on the search stack are kept
+// exactly (their number is bounded by the depth), so the back-edge check
+// against the stack is never approximate.
+template <typename Generator, typename Visited, typename Hash = std::hash<typename Generator::State>>
+ImplicitResult<Generator> isCyclicApproxDFS(const Generator& gen, Visited& visited) {
+    using State = typename Generator::State;
+    ImplicitResult<Generator> result;
+    Hash hasher;
+    auto hashOf = [&](const State& s) {
+        uint64_t h = hasher(s);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    };
+
+    struct Frame {
+        State state;
+        size_t begin, next, end;
+    };
+    std::vector<Frame> stack;
+    std::vector<State> successors;
+    std::unordered_set<State, Hash> onStack;
+
+    auto push = [&](const State& s) {
+        result.statesExplored++;
+        onStack.insert(s);
+        size_t begin = successors.size();
+        gen.forEachSuccessor(s, [&](const State& t) { successors.push_back(t); });
+        stack.push_back({s, begin, begin, successors.size()});
+    };
+
+    for (const State& init : gen.initialStates()) {
+        if (!visited.insert(hashOf(init))) continue;
+        push(init);
+
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.next == top.end) {
+                onStack.erase(top.state);
+                successors.resize(top.begin);
+                stack.pop_back();
+                continue;
+            }
+            State t = successors[top.next++];
+            if (onStack.count(t)) {
+                size_t k = stack.size();
+                while (!(stack[k - 1].state == t)) --k;
+                for (size_t i = k - 1; i < stack.size(); ++i) result.cycle.push_back(stack[i].state);
+                result.cyclic = true;
+                break;
+            }
+            if (visited.full()) {
+                result.budgetExhausted = true;
+                break;
+            }
+            if (visited.insert(hashOf(t))) push(t);
+        }
+        if (result.cyclic || result.budgetExhausted) break;
+    }
+    result.omissionProbability = visited.omissionProbability();
+    return result;
+}
+
+// Accepting-cycle (liveness) search. Generators used here additionally provide
+//   bool isAccepting(const State& s) const;
+// and the result is a lasso: a path from an initial state to the cycle, then
+// a cycle through at least one accepting state.
+template <typename Generator>
+struct LassoResult {
+    bool found = false;
+    std::vector<typename Generator::State> prefix; // initial state up to the cycle entry
+    std::vector<typename Generator::State> cycle;  // starts at the entry, closes back to it
+    size_t statesExplored = 0;
+};
+
+// Two bits of search state per state id, packed four to a byte.
+class ColorArray {
+public:
+    enum Color : uint8_t { WHITE = 0, CYAN = 1, BLUE = 2, RED = 3 };
+
+    void grow(size_t n) { bytes.resize((n + 3) / 4, 0); }
+    Color get(uint32_t id) const { return static_cast<Color>((bytes[id >> 2] >> (2 * (id & 3))) & 3); }
+    void set(uint32_t id, Color c) {
+        uint8_t& b = bytes[id >> 2];
+        b = (b & ~(3 << (2 * (id & 3)))) | (c << (2 * (id & 3)));
+    }
+
+private:
+    std::vector<uint8_t> bytes;
+};
+
+// Nested DFS (Courcoubetis-Vardi-Wolper-Yannakakis) with colors:
+//   cyan - on the outer (blue) DFS stack
+//   blue - outer search finished, not yet seen by an inner search
+//   red  - visited by an inner (red) search
+// The outer search starts an inner search from each accepting state in
+// postorder. Following Holzmann, the inner search stops as soon as it
+// reaches any state on the outer stack, since that state reaches the seed;
+// the outer search likewise reports a cycle when a back edge to the stack
+// touches an accepting state. Each state is expanded at most twice.
+template <typename Generator>
+LassoResult<Generator> nestedDFS(const Generator& gen) {
+    using State = typename Generator::State;
+    LassoResult<Generator> result;
+    StateTable<State> table;
+    ColorArray color;
+
+    struct Frame {
+        uint32_t id;
+        size_t begin, next, end;
+    };
+    std::vector<Frame> blue, red;
+    std::vector<State> successors;
+
+    auto enter = [&](std::vector<Frame>& stack, uint32_t id) {
+        size_t begin = successors.size();
+        State s = table.state(id);
+        gen.forEachSuccessor(s, [&](const State& t) { successors.push_back(t); });
+        stack.push_back({id, begin, begin, successors.size()});
+    };
+    auto intern = [&](const State& s) {
+        auto entry = table.insert(s);
+        if (entry.second) color.grow(table.size());
+        return entry.first;
+    };
+    auto blueIndex = [&](uint32_t id) {
+        size_t k = blue.size();
+        while (blue[k - 1].id != id) --k;
+        return k - 1;
+    };
+    // Lasso through the blue stack from position `entry` to its top, then
+    // along `tail` (red stack ids, possibly empty) back to the entry state.
+    auto buildLasso = [&](size_t entry, const std::vector<Frame>& tail) {
+        result.found = true;
+        for (size_t i = 0; i < entry; ++i) result.prefix.push_back(table.state(blue[i].id));
+        for (size_t i = entry; i < blue.size(); ++i) result.cycle.push_back(table.state(blue[i].id));
+        for (size_t i = 1; i < tail.size(); ++i) result.cycle.push_back(table.state(tail[i].id));
+    };
+
+    // Inner search from accepting `seed` (top of the blue stack)
+    auto redSearch = [&](uint32_t seed) {
+        red.clear();
+        enter(red, seed);
+        while (!red.empty()) {
+            Frame& top = red.back();
+            if (top.next == top.end) {
+                successors.resize(top.begin);
+                red.pop_back();
+                continue;
+            }
+            uint32_t id = intern(successors[top.next++]);
+            ColorArray::Color c = color.get(id);
+            if (c == ColorArray::CYAN) {
+                buildLasso(blueIndex(id), red);
+                return true;
+            }
+            if (c == ColorArray::BLUE) {
+                color.set(id, ColorArray::RED);
+                enter(red, id);
+            }
+        }
+        return false;
+    };
+
+    for (const State& init : gen.initialStates()) {
+        uint32_t rootId = intern(init);
+        if (color.get(rootId) != ColorArray::WHITE) continue;
+        color.set(rootId, ColorArray::CYAN);
+        enter(blue, rootId);
+
+        while (!blue.empty()) {
+            Frame& top = blue.back();
+            if (top.next < top.end) {
+                uint32_t s = top.id;
+                uint32_t id = intern(successors[top.next++]);
+                ColorArray::Color c = color.get(id);
+                if (c == ColorArray::CYAN &&
+                    (gen.isAccepting(table.state(s)) || gen.isAccepting(table.state(id)))) {
+                    buildLasso(blueIndex(id), {});
+                    result.statesExplored = table.size();
+                    return result;
+                }
+                if (c == ColorArray::WHITE) {
+                    color.set(id, ColorArray::CYAN);
+                    enter(blue, id);
+                }
+                continue;
+            }
+
+            // Postorder: the successors of top are no longer needed
+            uint32_t s = top.id;
+            successors.resize(top.begin);
+            if (gen.isAccepting(table.state(s))) {
+                if (redSearch(s)) {
+                    result.statesExplored = table.size();
+                    return result;
+                }
+                color.set(s, ColorArray::RED);
+            } else {
+                color.set(s, ColorArray::BLUE);
+            }
+            blue.pop_back();
+        }
+    }
+    result.statesExplored = table.size();
+    return result;
+}
+
+// SCC-based alternative: an iterative Tarjan pass that stops at the first
+// completed SCC containing an accepting state and at least one edge. The
+// witness is rebuilt with BFS: initial states to the accepting state, then
+// from it back to itself inside the SCC.
+template <typename Generator>
+LassoResult<Generator> acceptingCycleSCC(const Generator& gen) {
+    using State = typename Generator::State;
+    LassoResult<Generator> result;
+    StateTable<State> table;
+    std::vector<uint32_t> index, low, sccStack;
+    std::vector<int32_t> comp;
+    const uint32_t UNSEEN = UINT32_MAX;
+
+    struct Frame {
+        uint32_t id;
+        size_t begin, next, end;
+    };
+    std::vector<Frame> stack;
+    std::vector<State> successors;
+    uint32_t counter = 0;
+    int32_t numComps = 0;
+
+    auto intern = [&](const State& s) {
+        auto entry = table.insert(s);
+        if (entry.second) {
+            index.push_back(UNSEEN);
+            low.push_back(0);
+            comp.push_back(-1);
+        }
+        return entry.first;
+    };
+    auto enter = [&](uint32_t id) {
+        index[id] = low[id] = counter++;
+        sccStack.push_back(id);
+        size_t begin = successors.size();
+        State s = table.state(id);
+        gen.forEachSuccessor(s, [&](const State& t) { successors.push_back(t); });
+        stack.push_back({id, begin, begin, successors.size()});
+    };
+
+    int32_t acceptingComp = -1;
+    uint32_t seed = 0;
+    for (const State& init : gen.initialStates()) {
+        uint32_t rootId = intern(init);
+        if (index[rootId] != UNSEEN) continue;
+        enter(rootId);
+        while (!stack.empty() && acceptingComp == -1) {
+            Frame& top = stack.back();
+            if (top.next < top.end) {
+                uint32_t u = top.id;
+                uint32_t v = intern(successors[top.next++]);
+                if (index[v] == UNSEEN) {
+                    enter(v);
+                } else if (comp[v] == -1 && index[v] < low[u]) {
+                    low[u] = index[v];
+                }
+                continue;
+            }
+
+            uint32_t u = top.id;
+            size_t begin = top.begin, end = top.end;
+            if (low[u] == index[u]) {
+                bool accepting = false;
+                size_t first = sccStack.size();
+                do {
+                    --first;
+                    comp[sccStack[first]] = numComps;
+                } while (sccStack[first] != u);
+                for (size_t i = first; i < sccStack.size(); ++i) {
+                    if (gen.isAccepting(table.state(sccStack[i]))) {
+                        accepting = true;
+                        seed = sccStack[i];
+                    }
+                }
+                // A single-state SCC only counts with a self-loop
+                bool hasEdge = sccStack.size() - first > 1;
+                for (size_t i = begin; i < end && !hasEdge; ++i) hasEdge = successors[i] == table.state(u);
+                if (accepting && hasEdge) acceptingComp = numComps;
+                sccStack.resize(first);
+                numComps++;
+            }
+            successors.resize(begin);
+            stack.pop_back();
+            if (!stack.empty() && low[u] < low[stack.back().id]) low[stack.back().id] = low[u];
+        }
+        if (acceptingComp != -1) break;
+    }
+    result.statesExplored = table.size();
+    if (acceptingComp == -1) return result;
+
+    // Shortest path from any of `sources` to `target` over already-interned
+    // states, optionally restricted to the accepting SCC. The path has at
+    // least one edge unless `target` is itself a source.
+    auto bfsPath = [&](const std::vector<uint32_t>& sources, uint32_t target, bool insideScc) {
+        std::vector<uint32_t> parent(table.size(), UNSEEN), queue;
+        for (uint32_t src : sources) {
+            if (src == target && !insideScc) return std::vector<uint32_t>{target};
+            parent[src] = src;
+            queue.push_back(src);
+        }
+        for (size_t head = 0; head < queue.size(); ++head) {
+            uint32_t u = queue[head];
+            bool reached = false;
+            State s = table.state(u);
+            gen.forEachSuccessor(s, [&](const State& t) {
+                // The search stopped early, so successors may never have been interned
+                uint32_t v = table.lookup(t);
+                if (reached || v == table.NOT_FOUND || (insideScc && comp[v] != acceptingComp)) return;
+                if (v == target) {
+                    reached = true;
+                } else if (parent[v] == UNSEEN) {
+                    parent[v] = u;
+                    queue.push_back(v);
+                }
+            });
+            if (reached) {
+                std::vector<uint32_t> path{target};
+                for (uint32_t x = u;; x = parent[x]) {
+                    path.push_back(x);
+                    if (parent[x] == x) break;
+                }
+                return std::vector<uint32_t>(path.rbegin(), path.rend());
+            }
+        }
+        return std::vector<uint32_t>{};
+    };
+
+    // Initial states after the one that reached the accepting SCC were never
+    // interned; they cannot start the prefix either
+    std::vector<uint32_t> roots;
+    for (const State& init : gen.initialStates()) {
+        uint32_t id = table.lookup(init);
+        if (id != table.NOT_FOUND) roots.push_back(id);
+    }
+    std::vector<uint32_t> toSeed = bfsPath(roots, seed, false);
+    std::vector<uint32_t> loop = bfsPath({seed}, seed, true);
+
+    result.found = true;
+    for (size_t i = 0; i + 1 < toSeed.size(); ++i) result.prefix.push_back(table.state(toSeed[i]));
+    for (size_t i = 0; i + 1 < loop.size(); ++i) result.cycle.push_back(table.state(loop[i]));
+    return result;
+}
+
+// Adapter so the existing adjacency-matrix examples run on the implicit engines.
+struct MatrixGenerator {
+    using State = int;
+    const std::vector<std::vector<int>>& adjMatrix;
+
+    std::vector<State> initialStates() const {
+        std::vector<State> all(adjMatrix.size());
+        for (size_t i = 0; i < all.size(); ++i) all[i] = i;
+        return all;
+    }
+    template <class F>
+    void forEachSuccessor(const State& s, F f) const {
+        for (size_t v = 0; v < adjMatrix[s].size(); ++v) {
+            if (adjMatrix[s][v] == 1) f(static_cast<int>(v));
+        }
+    }
+};
+
+// Explicit graph with a set of accepting vertices, for the liveness engines.
+struct AcceptingMatrixGenerator : MatrixGenerator {
+    std::vector<int> accepting;
+    std::vector<int> initial = {0};
+
+    std::vector<State> initialStates() const { return initial; }
+    bool isAccepting(const State& s) const {
+        return std::find(accepting.begin(), accepting.end(), s) != accepting.end();
+    }
+};
+
+// Protocol model: `numCounters` counters packed 8 bits each into a 64-bit
+// state. Any counter below `limit` may be incremented. With `wrap` set, a
+// counter at `limit` may reset to zero, which creates cycles. States where
+// counter 0 is at its limit are accepting.
+struct CounterModel {
+    using State = uint64_t;
+    int numCounters;
+    int limit;
+    bool wrap;
+
+    std::vector<State> initialStates() const { return {0}; }
+    template <class F>
+    void forEachSuccessor(const State& s, F f) const {
+        for (int c = 0; c < numCounters; ++c) {
+            uint64_t value = (s >> (8 * c)) & 0xff;
+            if (value < static_cast<uint64_t>(limit)) {
+                f(s + (1ULL << (8 * c)));
+            } else if (wrap) {
+                f(s & ~(0xffULL << (8 * c)));
+            }
+        }
+    }
+    bool isAccepting(const State& s) const { return (s & 0xff) == static_cast<uint64_t>(limit); }
+};
+
+template <typename Generator, typename Print>
+void printResult(const char* engine, const ImplicitResult<Generator>& result, Print print) {
+    std::cout << "Result (" << engine << "): " << (result.cyclic ? "CYCLIC" : "ACYCLIC")
+              << ", states explored: " << result.statesExplored << std::endl;
+    if (result.cyclic) {
+        std::cout << "States in a cycle: ";
+        for (const auto& s : result.cycle) {
+            print(s);
+            std::cout << " -> ";
+        }
+        print(result.cycle[0]);
+        std::cout << std::endl;
+    }
+}
+
+template <typename Generator, typename Print>
+void printLasso(const char* engine, const LassoResult<Generator>& result, Print print) {
+    std::cout << "Result (" << engine << "): "
+              << (result.found ? "ACCEPTING CYCLE" : "no accepting cycle")
+              << ", states explored: " << result.statesExplored << std::endl;
+    if (result.found) {
+        std::cout << "Prefix: ";
+        for (const auto& s : result.prefix) {
+            print(s);
+            std::cout << " -> ";
+        }
+        std::cout << "[cycle]" << std::endl << "Cycle: ";
+        for (const auto& s : result.cycle) {
+            print(s);
+            std::cout << " -> ";
+        }
+        print(result.cycle[0]);
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "--- Implicit State-Space Cycle Detection ---" << std::endl;
+    auto printInt = [](int s) { std::cout << s; };
+    auto printCounters = [](uint64_t s) {
+        std::cout << "(" << (s & 0xff) << "," << ((s >> 8) & 0xff) << "," << ((s >> 16) & 0xff) << ")";
+    };
+
+    // Example: the adjacency-matrix test case through the generator adapter
+    std::cout << "\n--- Test Case: Matrix Adapter ---" << std::endl;
+    std::vector<std::vector<int>> cyclicGraph = {
+        {0, 1, 0, 0},
+        {0, 0, 1, 1},
+        {0, 0, 0, 0},
+        {0, 1, 0, 0} // Edge 3 -> 1 creates a cycle 1->3->1
+    };
+    MatrixGenerator matrix{cyclicGraph};
+    printResult("DFS", isCyclicImplicitDFS(matrix), printInt);
+    printResult("BFS", detectCycleImplicitBFS(matrix), printInt);
+
+    // Example: counter protocol with and without wrap-around
+    std::cout << "\n--- Test Case: Counter Protocol ---" << std::endl;
+    CounterModel monotone{3, 2, false};
+    CounterModel wrapping{3, 2, true};
+    printResult("DFS", isCyclicImplicitDFS(monotone), printCounters);
+    printResult("DFS", isCyclicImplicitDFS(wrapping), printCounters);
+    printResult("BFS", detectCycleImplicitBFS(wrapping), printCounters);
+
+    // Throughput: full exploration of an acyclic state space
+    std::cout << "\n--- Throughput: 5 Counters up to 24 (~9.8M states) ---" << std::endl;
+    CounterModel large{5, 24, false};
+    auto start = std::chrono::steady_clock::now();
+    auto result = isCyclicImplicitDFS(large);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Result (DFS): " << (result.cyclic ? "CYCLIC" : "ACYCLIC") << ", states: " << result.statesExplored
+              << ", " << static_cast<long long>(result.statesExplored / elapsed) << " states/s" << std::endl;
+
+    // Same search with a fixed-size visited set instead of stored states
+    std::cout << "\n--- Memory-Bounded Search ---" << std::endl;
+    BitstateVisited bitstate(8 << 20, 3);
+    HashCompactVisited compact(64 << 20);
+    auto runApprox = [&](const char* mode, auto& visited) {
+        auto begin = std::chrono::steady_clock::now();
+        auto approx = isCyclicApproxDFS(large, visited);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "Result (" << mode << "): " << (approx.cyclic ? "CYCLIC" : "ACYCLIC")
+                  << (approx.budgetExhausted ? " (budget exhausted, search incomplete)" : "")
+                  << ", states: " << approx.statesExplored << ", memory: " << (visited.memoryBytes() >> 20) << " MB"
+                  << ", " << static_cast<long long>(approx.statesExplored / seconds) << " states/s" << std::endl;
+        std::cout << "  false-omission probability per state: " << approx.omissionProbability
+                  << ", expected omitted states: " << approx.omissionProbability * approx.statesExplored << std::endl;
+    };
+    runApprox("bitstate, k=3", bitstate);
+    runApprox("hash compaction", compact);
+
+    // A reported cycle is always real; the wrapping model still finds one
+    BitstateVisited small(1 << 10, 3);
+    printResult("bitstate DFS", isCyclicApproxDFS(wrapping, small), printCounters);
+
+    // Liveness: cycles through accepting states only
+    std::cout << "\n--- Test Case: Accepting Cycles (Nested DFS / SCC) ---" << std::endl;
+    std::vector<std::vector<int>> lassoGraph = {
+        {0, 1, 0, 0, 0},
+        {0, 0, 1, 0, 0},
+        {0, 0, 0, 1, 1},
+        {0, 1, 0, 0, 0}, // 1->2->3->1
+        {0, 0, 0, 0, 0}
+    };
+    AcceptingMatrixGenerator notOnCycle{{lassoGraph}, {4}};
+    AcceptingMatrixGenerator onCycle{{lassoGraph}, {3}};
+    printLasso("nested DFS", nestedDFS(notOnCycle), printInt);
+    printLasso("nested DFS", nestedDFS(onCycle), printInt);
+    printLasso("SCC", acceptingCycleSCC(onCycle), printInt);
+    printLasso("nested DFS", nestedDFS(wrapping), printCounters);
+    printLasso("SCC", acceptingCycleSCC(wrapping), printCounters);
+
+    // Regression: the SCC search stops before interning every successor of
+    // the accepting component, and the lasso BFS must skip those
+    std::vector<std::vector<int>> earlyStopGraph = {
+        {0, 1, 1, 0},
+        {0, 0, 0, 1},
+        {0, 0, 0, 0},
+        {0, 1, 0, 0} // 1->3->1
+    };
+    AcceptingMatrixGenerator earlyStop{{earlyStopGraph}, {1}};
+    printLasso("nested DFS", nestedDFS(earlyStop), printInt);
+    printLasso("SCC", acceptingCycleSCC(earlyStop), printInt);
+
+    // Regression: with several initial states the search stops in the
+    // component of the first, so later ones are never interned
+    std::vector<std::vector<int>> multiInitGraph = {
+        {0, 1, 0},
+        {1, 0, 0}, // 0->1->0
+        {0, 0, 0}
+    };
+    AcceptingMatrixGenerator multiInit{{multiInitGraph}, {0}, {0, 2}};
+    printLasso("nested DFS", nestedDFS(multiInit), printInt);
+    printLasso("SCC", acceptingCycleSCC(multiInit), printInt);
+
+    std::cout << "\n--- Throughput: Liveness Check Without Accepting Cycle ---" << std::endl;
+    for (int engine = 0; engine < 2; ++engine) {
+        auto begin = std::chrono::steady_clock::now();
+        auto lasso = engine == 0 ? nestedDFS(large) : acceptingCycleSCC(large);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "Result (" << (engine == 0 ? "nested DFS" : "SCC") << "): "
+                  << (lasso.found ? "ACCEPTING CYCLE" : "no accepting cycle") << ", states: " << lasso.statesExplored
+                  << ", " << static_cast<long long>(lasso.statesExplored / seconds) << " states/s" << std::endl;
+    }
+
+    return 0;
+}
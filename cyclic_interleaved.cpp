@@ -0,0 +1,339 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+// Batched reachability and cycle-witness queries with interleaved traversals
+// (asynchronous memory access chaining).
+//
+// One DFS step on a large graph is a chain of dependent loads: the edge list
+// entry gives a vertex, its visited word decides whether to open it, and its
+// offsets give the next list. Each of them is a likely cache miss, so a
+// single traversal runs at DRAM latency. Independent queries have no such
+// dependency between them, so the engine keeps a group of them in flight,
+// each as a small state machine: a step runs until the slot needs memory it
+// has not touched yet, issues a software prefetch for it and yields, and the
+// engine moves on to the next slot. By the time the round comes back the
+// line has arrived, and the misses of the whole group overlap.
+//
+// A slot walks the DFS stage by stage:
+//   ADVANCE  take the next edge of the top frame (pop exhausted frames);
+//            prefetch the target's visited word
+//   CHECK    skip a visited target, otherwise mark it and prefetch its
+//            offsets
+//   OPEN     push a frame for the target's list and prefetch the list
+// The DFS stack is the path from the source, so a query that meets its
+// target already holds the witness path. Visited marks are one bit per
+// slot in a 64-bit word per vertex; a finished slot clears its bits from
+// the vertices it touched before taking the next query.
+
+struct CSRGraph {
+    std::vector<uint32_t> offsets, targets;
+
+    uint32_t numVertices() const { return offsets.size() - 1; }
+
+    static CSRGraph fromEdges(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+        CSRGraph g;
+        g.offsets.assign(n + 1, 0);
+        for (const auto& e : edges) g.offsets[e.first + 1]++;
+        for (uint32_t i = 0; i < n; ++i) g.offsets[i + 1] += g.offsets[i];
+        g.targets.resize(edges.size());
+        std::vector<uint32_t> fill(g.offsets.begin(), g.offsets.end() - 1);
+        for (const auto& e : edges) g.targets[fill[e.first]++] = e.second;
+        return g;
+    }
+};
+
+struct ReachQuery {
+    uint32_t source, target;
+};
+
+struct ReachAnswers {
+    std::vector<uint8_t> reachable;
+    std::vector<std::vector<uint32_t>> paths; // source .. target, if requested
+    uint64_t probes = 0;                      // visited-word lookups
+};
+
+// One query at a time, plain iterative DFS: the latency-bound baseline
+ReachAnswers reachSequential(const CSRGraph& g, const std::vector<ReachQuery>& queries, bool withPaths) {
+    ReachAnswers answers;
+    answers.reachable.assign(queries.size(), 0);
+    if (withPaths) answers.paths.resize(queries.size());
+    std::vector<uint32_t> stamp(g.numVertices(), 0);
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // vertex, next edge
+    for (size_t q = 0; q < queries.size(); ++q) {
+        uint32_t source = queries[q].source, target = queries[q].target, id = q + 1;
+        stack.assign(1, {source, g.offsets[source]});
+        stamp[source] = id;
+        bool found = source == target;
+        while (!found && !stack.empty()) {
+            auto& [v, next] = stack.back();
+            if (next == g.offsets[v + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            uint32_t t = g.targets[next++];
+            answers.probes++;
+            if (t == target) {
+                found = true;
+            } else if (stamp[t] != id) {
+                stamp[t] = id;
+                stack.push_back({t, g.offsets[t]});
+            }
+        }
+        answers.reachable[q] = found;
+        if (found && withPaths) {
+            for (const auto& frame : stack) answers.paths[q].push_back(frame.first);
+            if (source != target) answers.paths[q].push_back(target);
+        }
+    }
+    return answers;
+}
+
+class InterleavedReachability {
+public:
+    static constexpr uint32_t MAX_GROUP = 64; // one visited bit per slot
+
+    InterleavedReachability(const CSRGraph& g, uint32_t groupSize)
+        : g(g), visited(g.numVertices(), 0), slots(std::min(std::max(groupSize, 1u), MAX_GROUP)) {
+        for (size_t i = 0; i < slots.size(); ++i) slots[i].bit = 1ULL << i;
+    }
+
+    ReachAnswers run(const std::vector<ReachQuery>& queries, bool withPaths) {
+        ReachAnswers answers;
+        answers.reachable.assign(queries.size(), 0);
+        if (withPaths) answers.paths.resize(queries.size());
+        size_t nextQuery = 0, active = 0;
+        for (Slot& s : slots) {
+            if (nextQuery < queries.size()) {
+                start(s, nextQuery++, queries);
+                active++;
+            }
+        }
+        // Round-robin over the group; each step ends on a prefetch
+        while (active > 0) {
+            for (Slot& s : slots) {
+                if (s.stage == IDLE) continue;
+                if (!step(s, answers)) continue;
+                finish(s, answers, withPaths);
+                if (nextQuery < queries.size()) {
+                    start(s, nextQuery++, queries);
+                } else {
+                    active--;
+                }
+            }
+        }
+        return answers;
+    }
+
+private:
+    enum Stage { IDLE, ADVANCE, CHECK, OPEN };
+
+    struct Frame {
+        uint32_t vertex, next, end;
+    };
+
+    struct Slot {
+        Stage stage = IDLE;
+        uint64_t bit;
+        size_t query;
+        uint32_t target, candidate;
+        bool found;
+        std::vector<Frame> stack;
+        std::vector<uint32_t> touched;
+    };
+
+    void start(Slot& s, size_t q, const std::vector<ReachQuery>& queries) {
+        s.query = q;
+        s.target = queries[q].target;
+        s.candidate = queries[q].source;
+        s.found = s.candidate == s.target;
+        s.stack.clear();
+        visited[s.candidate] |= s.bit;
+        s.touched.push_back(s.candidate);
+        __builtin_prefetch(&g.offsets[s.candidate]);
+        s.stage = OPEN;
+    }
+
+    // Advance one slot up to its next prefetch; true once the query is decided
+    bool step(Slot& s, ReachAnswers& answers) {
+        if (s.found) return true;
+        while (true) {
+            switch (s.stage) {
+                case OPEN: {
+                    uint32_t v = s.candidate;
+                    s.stack.push_back({v, g.offsets[v], g.offsets[v + 1]});
+                    __builtin_prefetch(&g.targets[s.stack.back().next]);
+                    s.stage = ADVANCE;
+                    return false;
+                }
+                case ADVANCE: {
+                    Frame& top = s.stack.back();
+                    if (top.next == top.end) {
+                        s.stack.pop_back();
+                        if (s.stack.empty()) return true;
+                        break;
+                    }
+                    uint32_t t = g.targets[top.next++];
+                    answers.probes++;
+                    if (t == s.target) {
+                        s.found = true;
+                        return true;
+                    }
+                    s.candidate = t;
+                    __builtin_prefetch(&visited[t], 1);
+                    s.stage = CHECK;
+                    return false;
+                }
+                case CHECK: {
+                    uint32_t t = s.candidate;
+                    if (visited[t] & s.bit) {
+                        s.stage = ADVANCE;
+                        break;
+                    }
+                    visited[t] |= s.bit;
+                    s.touched.push_back(t);
+                    __builtin_prefetch(&g.offsets[t]);
+                    s.stage = OPEN;
+                    return false;
+                }
+                default:
+                    return true;
+            }
+        }
+    }
+
+    void finish(Slot& s, ReachAnswers& answers, bool withPaths) {
+        answers.reachable[s.query] = s.found;
+        if (s.found && withPaths) {
+            std::vector<uint32_t>& path = answers.paths[s.query];
+            for (const Frame& f : s.stack) path.push_back(f.vertex);
+            if (path.empty() || path.back() != s.target) path.push_back(s.target);
+        }
+        for (uint32_t v : s.touched) visited[v] &= ~s.bit;
+        s.touched.clear();
+        s.stage = IDLE;
+    }
+
+    const CSRGraph& g;
+    std::vector<uint64_t> visited;
+    std::vector<Slot> slots;
+};
+
+// Edge (u, v) lies on a cycle iff v reaches u; the path v .. u is the witness
+std::vector<ReachQuery> witnessQueries(const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+    std::vector<ReachQuery> queries;
+    for (const auto& [u, v] : edges) queries.push_back({v, u});
+    return queries;
+}
+
+void printCycle(const std::vector<uint32_t>& cycle) {
+    if (cycle.empty()) {
+        std::cout << "Result: Graph is ACYCLIC." << std::endl;
+        return;
+    }
+    std::cout << "Result: Graph is CYCLIC. Vertices in a cycle: ";
+    for (uint32_t v : cycle) std::cout << v << " -> ";
+    std::cout << cycle[0] << std::endl;
+}
+
+int main() {
+    std::cout << "--- Interleaved Reachability and Witness Queries ---" << std::endl;
+
+    // Example: the 4-vertex test case; one witness query per edge
+    std::cout << "\n--- Test Case: Cyclic Graph ---" << std::endl;
+    std::vector<std::pair<uint32_t, uint32_t>> smallEdges = {{0, 1}, {1, 2}, {1, 3}, {3, 1}};
+    CSRGraph small = CSRGraph::fromEdges(4, smallEdges);
+    ReachAnswers witnesses = InterleavedReachability(small, 4).run(witnessQueries(smallEdges), true);
+    std::vector<uint32_t> cycle;
+    for (size_t i = 0; i < smallEdges.size() && cycle.empty(); ++i) {
+        if (witnesses.reachable[i]) cycle = witnesses.paths[i];
+    }
+    printCycle(cycle);
+
+    // Throughput: 8M vertices in 32K components of 256, each a random DAG
+    // with 3 forward edges per vertex; vertex ids are shuffled, so every
+    // step of a traversal lands on a cold cache line
+    const uint32_t n = 1 << 23, block = 256, degree = 3;
+    std::cout << "\n--- Throughput: 8M Vertices, 24M Edges, Scattered Components ---" << std::endl;
+    std::mt19937 rng(75);
+    std::vector<uint32_t> id(n);
+    std::iota(id.begin(), id.end(), 0);
+    std::shuffle(id.begin(), id.end(), rng);
+    auto vertex = [&](uint32_t component, uint32_t rank) { return id[component * block + rank]; };
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(static_cast<size_t>(n) * degree + 8192);
+    for (uint32_t c = 0; c < n / block; ++c) {
+        for (uint32_t r = 0; r + 1 < block; ++r) {
+            for (uint32_t d = 0; d < degree; ++d) edges.push_back({vertex(c, r), vertex(c, r + 1 + rng() % (block - r - 1))});
+        }
+    }
+    // Back edges from a high to a low rank; each closes a cycle iff its head
+    // reaches its tail
+    std::vector<std::pair<uint32_t, uint32_t>> backEdges;
+    for (int i = 0; i < 8192; ++i) {
+        uint32_t c = rng() % (n / block), low = rng() % (block / 2), high = block / 2 + rng() % (block / 2);
+        backEdges.push_back({vertex(c, high), vertex(c, low)});
+    }
+    edges.insert(edges.end(), backEdges.begin(), backEdges.end());
+    CSRGraph g = CSRGraph::fromEdges(n, edges);
+    std::vector<std::pair<uint32_t, uint32_t>>().swap(edges);
+
+    std::vector<ReachQuery> reachQueries;
+    for (int i = 0; i < 16384; ++i) {
+        uint32_t c = rng() % (n / block);
+        reachQueries.push_back({vertex(c, rng() % block), vertex(c, rng() % block)});
+    }
+    std::vector<ReachQuery> cycleQueries = witnessQueries(backEdges);
+
+    auto report = [&](const std::string& name, const std::vector<ReachQuery>& queries, bool withPaths, uint32_t group,
+                      const ReachAnswers& expected) {
+        auto start = std::chrono::steady_clock::now();
+        ReachAnswers answers = group == 0 ? reachSequential(g, queries, withPaths)
+                                          : InterleavedReachability(g, group).run(queries, withPaths);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t yes = std::count(answers.reachable.begin(), answers.reachable.end(), 1);
+        bool agrees = expected.reachable.empty() || answers.reachable == expected.reachable;
+        std::cout << name << ": " << seconds << " s, " << static_cast<long long>(queries.size() / seconds) << " queries/s, "
+                  << seconds * 1e9 / answers.probes << " ns/probe, " << yes << " reachable"
+                  << (agrees ? "" : " (MISMATCH)") << std::endl;
+        return answers;
+    };
+
+    const uint32_t groups[] = {1, 4, 8, 16, 32, 64};
+    std::cout << "Reachability, " << reachQueries.size() << " queries:" << std::endl;
+    ReachAnswers expected = report("  sequential DFS ", reachQueries, false, 0, {});
+    for (uint32_t group : groups) {
+        std::string name = "  interleaved x" + std::to_string(group);
+        report(name + std::string(17 - name.size(), ' '), reachQueries, false, group, expected);
+    }
+
+    std::cout << "Cycle witnesses, " << cycleQueries.size() << " back edges:" << std::endl;
+    expected = report("  sequential DFS ", cycleQueries, true, 0, {});
+    ReachAnswers interleaved;
+    for (uint32_t group : groups) {
+        std::string name = "  interleaved x" + std::to_string(group);
+        interleaved = report(name + std::string(17 - name.size(), ' '), cycleQueries, true, group, expected);
+    }
+
+    // Every witness must be a real path from the head of its edge to the tail
+    size_t valid = 0;
+    for (size_t q = 0; q < cycleQueries.size(); ++q) {
+        const std::vector<uint32_t>& path = interleaved.paths[q];
+        if (!interleaved.reachable[q]) continue;
+        bool ok = path.front() == cycleQueries[q].source && path.back() == cycleQueries[q].target;
+        for (size_t i = 0; ok && i + 1 < path.size(); ++i) {
+            ok = std::find(g.targets.begin() + g.offsets[path[i]], g.targets.begin() + g.offsets[path[i] + 1], path[i + 1]) !=
+                 g.targets.begin() + g.offsets[path[i] + 1];
+        }
+        valid += ok;
+    }
+    std::cout << "Valid witness paths: " << valid << " of "
+              << std::count(interleaved.reachable.begin(), interleaved.reachable.end(), 1) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,257 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdint>
+
+// k2-tree (k = 2) adjacency matrix for block-clustered graphs.
+//
+// The side x side matrix (side = next power of two >= n) is split into four
+// quadrants recursively; each node stores one bit per quadrant telling
+// whether it holds any edge, and only non-empty quadrants are refined. Bits
+// of all internal levels are concatenated breadth-first into T, the bits of
+// the last level (single cells) into L. Empty regions cost nothing below
+// their first zero bit, and dense clusters share their upper levels, so a
+// clustered matrix takes a few bits per edge.
+//
+// Navigation uses rank on T: the children of the node whose bit sits at
+// position x start at rank1(T, x) * 4. A row query (successors) descends
+// into the two quadrants covering that row at every level, a column query
+// (predecessors) into the two covering that column, so both directions cost
+// the same. Kahn's in-degrees come from column queries, the queue and the
+// witness DFS use row queries.
+
+class BitVector {
+public:
+    void push4(uint32_t bits) {
+        if (size % 64 == 0) words.push_back(0);
+        words.back() |= static_cast<uint64_t>(bits) << (size % 64);
+        size += 4;
+    }
+    bool get(size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+    size_t bits() const { return size; }
+
+    // Ones before each word; a rank is one lookup plus one popcount
+    void buildRank() {
+        wordRank.resize(words.size());
+        uint32_t sum = 0;
+        for (size_t w = 0; w < words.size(); ++w) {
+            wordRank[w] = sum;
+            sum += __builtin_popcountll(words[w]);
+        }
+    }
+    // Number of ones in positions [0, i]
+    uint32_t rank1(size_t i) const {
+        return wordRank[i / 64] + __builtin_popcountll(words[i / 64] & (~0ULL >> (63 - i % 64)));
+    }
+    size_t memoryBytes() const { return words.size() * 8 + wordRank.size() * 4; }
+
+private:
+    std::vector<uint64_t> words;
+    std::vector<uint32_t> wordRank;
+    size_t size = 0;
+};
+
+class K2Tree {
+public:
+    K2Tree(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>>& edges) : n(n) {
+        height = 1;
+        while ((1ULL << height) < n) height++;
+        side = 1ULL << height;
+
+        // Morton order (row bit above column bit at every level) is exactly
+        // the breadth-first order of nodes within each level
+        std::vector<uint64_t> codes(edges.size());
+        for (size_t i = 0; i < edges.size(); ++i) codes[i] = (spread(edges[i].first) << 1) | spread(edges[i].second);
+        std::sort(codes.begin(), codes.end());
+        codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+        numEdges = codes.size();
+
+        for (int level = 0; level < height; ++level) {
+            int shift = 2 * (height - level - 1);
+            BitVector& out = level == height - 1 ? L : T;
+            for (size_t i = 0; i < codes.size();) {
+                uint64_t node = codes[i] >> (shift + 2);
+                uint32_t children = 0;
+                for (; i < codes.size() && codes[i] >> (shift + 2) == node; ++i) children |= 1u << ((codes[i] >> shift) & 3);
+                out.push4(children);
+            }
+        }
+        T.buildRank();
+    }
+
+    uint32_t numVertices() const { return n; }
+    size_t size() const { return numEdges; }
+    size_t memoryBytes() const { return T.memoryBytes() + L.memoryBytes(); }
+
+    template <class F>
+    void forEachSuccessor(uint32_t row, F f) const {
+        if (numEdges > 0) rowQuery(side, row, 0, 0, f);
+    }
+
+    template <class F>
+    void forEachPredecessor(uint32_t col, F f) const {
+        if (numEdges > 0) columnQuery(side, col, 0, 0, f);
+    }
+
+private:
+    // Interleave: bit i of x moves to bit 2i
+    static uint64_t spread(uint32_t x) {
+        uint64_t v = x;
+        v = (v | (v << 16)) & 0x0000ffff0000ffffULL;
+        v = (v | (v << 8)) & 0x00ff00ff00ff00ffULL;
+        v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        v = (v | (v << 2)) & 0x3333333333333333ULL;
+        v = (v | (v << 1)) & 0x5555555555555555ULL;
+        return v;
+    }
+
+    // `base` is the position of the current node's first child bit in T ++ L
+    template <class F>
+    void rowQuery(uint64_t size, uint64_t p, uint64_t q, uint64_t base, F& f) const {
+        uint64_t half = size / 2, r = p / half;
+        for (uint64_t j = 0; j < 2; ++j) {
+            uint64_t pos = base + 2 * r + j;
+            if (pos < T.bits()) {
+                if (T.get(pos)) rowQuery(half, p % half, q + half * j, T.rank1(pos) * 4, f);
+            } else if (L.get(pos - T.bits())) {
+                f(static_cast<uint32_t>(q + j));
+            }
+        }
+    }
+
+    template <class F>
+    void columnQuery(uint64_t size, uint64_t q, uint64_t p, uint64_t base, F& f) const {
+        uint64_t half = size / 2, c = q / half;
+        for (uint64_t i = 0; i < 2; ++i) {
+            uint64_t pos = base + 2 * i + c;
+            if (pos < T.bits()) {
+                if (T.get(pos)) columnQuery(half, q % half, p + half * i, T.rank1(pos) * 4, f);
+            } else if (L.get(pos - T.bits())) {
+                f(static_cast<uint32_t>(p + i));
+            }
+        }
+    }
+
+    uint32_t n;
+    int height;
+    uint64_t side;
+    size_t numEdges = 0;
+    BitVector T, L;
+};
+
+// Kahn's algorithm on the k2-tree; leftover vertices are searched with an
+// iterative DFS whose frames hold their row's successors.
+std::vector<uint32_t> detectCycleK2(const K2Tree& g) {
+    uint32_t n = g.numVertices();
+    std::vector<uint32_t> inDegree(n, 0);
+    for (uint32_t v = 0; v < n; ++v) g.forEachPredecessor(v, [&](uint32_t) { inDegree[v]++; });
+
+    std::vector<uint32_t> queue;
+    queue.reserve(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (inDegree[v] == 0) queue.push_back(v);
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        g.forEachSuccessor(queue[head], [&](uint32_t t) {
+            if (--inDegree[t] == 0) queue.push_back(t);
+        });
+    }
+    if (queue.size() == n) return {};
+
+    struct Frame {
+        uint32_t vertex;
+        size_t next;
+        std::vector<uint32_t> successors;
+    };
+    std::vector<uint8_t> state(n, 0); // 0 = unvisited, 1 = on stack, 2 = done
+    std::vector<Frame> stack;
+    auto enter = [&](uint32_t v) {
+        state[v] = 1;
+        stack.push_back({v, 0, {}});
+        g.forEachSuccessor(v, [&](uint32_t t) {
+            if (inDegree[t] > 0) stack.back().successors.push_back(t);
+        });
+    };
+    for (uint32_t root = 0; root < n; ++root) {
+        if (inDegree[root] == 0 || state[root] != 0) continue;
+        enter(root);
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.next == top.successors.size()) {
+                state[top.vertex] = 2;
+                stack.pop_back();
+                continue;
+            }
+            uint32_t v = top.successors[top.next++];
+            if (state[v] == 1) {
+                size_t k = stack.size();
+                while (stack[k - 1].vertex != v) --k;
+                std::vector<uint32_t> cycle;
+                for (size_t i = k - 1; i < stack.size(); ++i) cycle.push_back(stack[i].vertex);
+                return cycle;
+            }
+            if (state[v] == 0) enter(v);
+        }
+    }
+    return {};
+}
+
+void printCycle(const std::vector<uint32_t>& cycle) {
+    if (cycle.empty()) {
+        std::cout << "Result: Graph is ACYCLIC." << std::endl;
+        return;
+    }
+    std::cout << "Result: Graph is CYCLIC. Vertices in a cycle: ";
+    for (uint32_t v : cycle) std::cout << v << " -> ";
+    std::cout << cycle[0] << std::endl;
+}
+
+int main() {
+    std::cout << "--- k2-Tree Adjacency Matrix ---" << std::endl;
+
+    // Example: the 4-vertex test case
+    std::cout << "\n--- Test Case: Cyclic Graph ---" << std::endl;
+    K2Tree small(4, {{0, 1}, {1, 2}, {1, 3}, {3, 1}});
+    std::cout << "Successors of 1: ";
+    small.forEachSuccessor(1, [](uint32_t t) { std::cout << t << " "; });
+    std::cout << ", predecessors of 1: ";
+    small.forEachPredecessor(1, [](uint32_t u) { std::cout << u << " "; });
+    std::cout << std::endl;
+    printCycle(detectCycleK2(small));
+
+    // Throughput: 2048 clusters of 512 vertices, each a 10%-dense DAG, a few
+    // forward links between clusters and one back edge closing a cycle
+    std::cout << "\n--- Throughput: 1M Vertices in Dense Clusters ---" << std::endl;
+    const uint32_t clusters = 2048, clusterSize = 512, n = clusters * clusterSize;
+    std::mt19937 rng(21);
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    for (uint32_t c = 0; c < clusters; ++c) {
+        uint32_t base = c * clusterSize;
+        for (uint32_t i = 0; i < clusterSize; ++i) {
+            for (uint32_t j = i + 1; j < clusterSize; ++j) {
+                if (rng() % 10 == 0) edges.push_back({base + i, base + j});
+            }
+        }
+        if (c + 1 < clusters) edges.push_back({base + rng() % clusterSize, base + clusterSize + rng() % clusterSize});
+    }
+    edges.push_back({n - 1, n - clusterSize});
+
+    auto start = std::chrono::steady_clock::now();
+    K2Tree big(n, edges);
+    double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t bitsetBytes = static_cast<size_t>(n) * n / 8;
+    size_t csrBytes = (static_cast<size_t>(n) + 1 + big.size()) * 4;
+    std::cout << "Edges: " << big.size() << ", k2-tree: " << (big.memoryBytes() >> 20) << " MB ("
+              << 8.0 * big.memoryBytes() / big.size() << " bits/edge), CSR: " << (csrBytes >> 20)
+              << " MB, bitset: " << (bitsetBytes >> 30) << " GB, build " << buildSeconds << " s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> cycle = detectCycleK2(big);
+    double detectSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Detection: " << detectSeconds << " s (" << static_cast<long long>(2 * big.size() / detectSeconds)
+              << " edge visits/s), cycle length " << cycle.size() << std::endl;
+
+    return 0;
+}
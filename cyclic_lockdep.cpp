@@ -0,0 +1,371 @@
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <execinfo.h>
+#include <unistd.h>
+
+// Lockdep-style runtime lock-order checking.
+//
+// Every TrackedMutex belongs to a LockClass. Acquiring class B while holding
+// class A records the dependency A -> B in a global lock-class graph. An edge
+// that was already seen is found with a lock-free hash lookup and costs no
+// allocation or stack capture. A new edge is added to the graph under a mutex
+// with an incremental (Pearce-Kelly) topological order check, so only the
+// region between the two classes is searched. If the edge would close a cycle, the
+// inverted lock order is reported with the stack of every edge on the cycle.
+
+const int MAX_CLASSES = 4096;
+const int MAX_HELD = 48;
+const int MAX_FRAMES = 16;
+const int EDGE_TABLE_SIZE = 1 << 16; // power of two, open addressing
+
+struct StackTrace {
+    void* frames[MAX_FRAMES];
+    int depth = 0;
+
+    void capture() { depth = backtrace(frames, MAX_FRAMES); }
+    void print() const { backtrace_symbols_fd(frames, depth, STDOUT_FILENO); }
+};
+
+class LockClass {
+public:
+    explicit LockClass(const char* name);
+    const char* name;
+    int id;
+};
+
+class LockGraph {
+public:
+    static LockGraph& instance() {
+        static LockGraph graph;
+        return graph;
+    }
+
+    int registerClass(LockClass* cls) {
+        std::lock_guard<std::mutex> guard(graphMutex);
+        if (numClasses == MAX_CLASSES) {
+            // The per-class arrays are fixed; running on would corrupt them
+            std::cerr << "lockdep: more than " << MAX_CLASSES << " lock classes (registering "
+                      << cls->name << "), raise MAX_CLASSES" << std::endl;
+            std::abort();
+        }
+        int id = numClasses++;
+        classes[id] = cls;
+        ord[id] = id;
+        return id;
+    }
+
+    // Hot path: record dependency from -> to. Already-known edges only touch
+    // the lock-free table.
+    void addDependency(int from, int to, void* heldSite) {
+        uint64_t key = edgeKey(from, to);
+        if (findEdge(key)) return;
+        addNewDependency(from, to, key, heldSite);
+    }
+
+    long long newEdgeCount() const { return newEdges.load(std::memory_order_relaxed); }
+    long long violationCount() const { return violations.load(std::memory_order_relaxed); }
+
+private:
+    struct EdgeInfo {
+        void* heldSite;           // call site that acquired `from`
+        StackTrace acquireStack;  // where `to` was acquired while holding `from`
+    };
+
+    static uint64_t edgeKey(int from, int to) {
+        // +1 keeps 0 free as the empty-slot marker
+        return ((static_cast<uint64_t>(from) << 32) | static_cast<uint32_t>(to)) + 1;
+    }
+
+    static size_t slotOf(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return key & (EDGE_TABLE_SIZE - 1);
+    }
+
+    bool findEdge(uint64_t key) const {
+        for (size_t i = slotOf(key);; i = (i + 1) & (EDGE_TABLE_SIZE - 1)) {
+            uint64_t k = edgeTable[i].load(std::memory_order_acquire);
+            if (k == key) return true;
+            if (k == 0) return false;
+        }
+    }
+
+    // Find the slot a new key will occupy. The caller holds graphMutex, so no
+    // other writer competes for it; the key is stored with release semantics
+    // once the edge info is filled in.
+    size_t reserveSlot(uint64_t key) {
+        size_t i = slotOf(key);
+        while (edgeTable[i].load(std::memory_order_relaxed) != 0) {
+            i = (i + 1) & (EDGE_TABLE_SIZE - 1);
+        }
+        return i;
+    }
+
+    void addNewDependency(int from, int to, uint64_t key, void* heldSite) {
+        std::lock_guard<std::mutex> guard(graphMutex);
+        if (findEdge(key)) return;
+        if (newEdges.load(std::memory_order_relaxed) >= EDGE_TABLE_SIZE / 2) {
+            // Dropping the edge would silently end detection, like MAX_CLASSES
+            std::cerr << "lockdep: more than " << EDGE_TABLE_SIZE / 2 << " lock dependencies (adding "
+                      << classes[from]->name << " -> " << classes[to]->name << "), raise EDGE_TABLE_SIZE" << std::endl;
+            std::abort();
+        }
+
+        size_t slot = reserveSlot(key);
+        edgeInfo[slot].heldSite = heldSite;
+        edgeInfo[slot].acquireStack.capture();
+
+        if (tryAddToDag(from, to)) {
+            out[from].push_back(to);
+            in[to].push_back(from);
+        } else {
+            violations.fetch_add(1, std::memory_order_relaxed);
+            reportCycle(from, to, slot);
+        }
+        newEdges.fetch_add(1, std::memory_order_relaxed);
+        edgeTable[slot].store(key, std::memory_order_release);
+    }
+
+    // Slot of an edge that is already published; called under graphMutex.
+    size_t findSlot(int from, int to) const {
+        uint64_t key = edgeKey(from, to);
+        size_t i = slotOf(key);
+        while (edgeTable[i].load(std::memory_order_relaxed) != key) {
+            i = (i + 1) & (EDGE_TABLE_SIZE - 1);
+        }
+        return i;
+    }
+
+    // Pearce-Kelly insertion over lock classes; false if from -> to closes a cycle.
+    bool tryAddToDag(int from, int to) {
+        if (from == to) return false;
+        if (ord[from] < ord[to]) return true;
+
+        int lb = ord[to], ub = ord[from];
+        ++epoch;
+        std::vector<int> forward, backward, stack{to};
+        mark[to] = epoch;
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            forward.push_back(x);
+            for (int y : out[x]) {
+                if (y == from) return false;
+                if (mark[y] != epoch && ord[y] < ub) {
+                    mark[y] = epoch;
+                    stack.push_back(y);
+                }
+            }
+        }
+
+        stack.assign(1, from);
+        mark[from] = epoch;
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            backward.push_back(x);
+            for (int y : in[x]) {
+                if (mark[y] != epoch && ord[y] > lb) {
+                    mark[y] = epoch;
+                    stack.push_back(y);
+                }
+            }
+        }
+
+        std::vector<int> slots;
+        for (int x : backward) slots.push_back(ord[x]);
+        for (int x : forward) slots.push_back(ord[x]);
+        std::sort(slots.begin(), slots.end());
+        auto byOrd = [this](int a, int b) { return ord[a] < ord[b]; };
+        std::sort(backward.begin(), backward.end(), byOrd);
+        std::sort(forward.begin(), forward.end(), byOrd);
+        size_t k = 0;
+        for (int x : backward) ord[x] = slots[k++];
+        for (int x : forward) ord[x] = slots[k++];
+        return true;
+    }
+
+    // from -> to closes a cycle: find the existing path to ~> from.
+    void reportCycle(int from, int to, size_t newSlot) {
+        std::vector<int> parent(numClasses, -1);
+        std::vector<int> queue{to};
+        parent[to] = to;
+        for (size_t head = 0; head < queue.size() && parent[from] == -1; ++head) {
+            int x = queue[head];
+            for (int y : out[x]) {
+                if (parent[y] == -1) {
+                    parent[y] = x;
+                    queue.push_back(y);
+                }
+            }
+        }
+
+        std::vector<int> cyclePath;
+        for (int x = from; x != to; x = parent[x]) cyclePath.push_back(x);
+        cyclePath.push_back(to);
+        std::reverse(cyclePath.begin(), cyclePath.end());
+
+        std::cout << "\n=== POSSIBLE DEADLOCK: lock order inversion ===" << std::endl;
+        std::cout << "New dependency: " << classes[from]->name << " -> " << classes[to]->name << std::endl;
+        std::cout << "Lock classes in cycle: ";
+        for (int c : cyclePath) std::cout << classes[c]->name << " -> ";
+        std::cout << classes[to]->name << std::endl;
+
+        printEdge(from, to, newSlot);
+        for (size_t i = 0; i + 1 < cyclePath.size(); ++i) {
+            printEdge(cyclePath[i], cyclePath[i + 1], findSlot(cyclePath[i], cyclePath[i + 1]));
+        }
+        std::cout << "===============================================" << std::endl;
+    }
+
+    void printEdge(int from, int to, size_t slot) {
+        std::cout << "\n-- " << classes[to]->name << " acquired while holding "
+                  << classes[from]->name << " --" << std::endl;
+        std::cout << classes[from]->name << " acquired at:" << std::endl;
+        backtrace_symbols_fd(&edgeInfo[slot].heldSite, 1, STDOUT_FILENO);
+        std::cout << "Stack acquiring " << classes[to]->name << ":" << std::endl;
+        edgeInfo[slot].acquireStack.print();
+    }
+
+    std::atomic<uint64_t> edgeTable[EDGE_TABLE_SIZE] = {};
+    EdgeInfo edgeInfo[EDGE_TABLE_SIZE];
+    std::atomic<long long> newEdges{0}, violations{0};
+
+    std::mutex graphMutex;
+    LockClass* classes[MAX_CLASSES] = {};
+    int numClasses = 0;
+    int ord[MAX_CLASSES] = {};
+    unsigned mark[MAX_CLASSES] = {};
+    unsigned epoch = 0;
+    std::vector<int> out[MAX_CLASSES], in[MAX_CLASSES];
+};
+
+LockClass::LockClass(const char* name) : name(name), id(LockGraph::instance().registerClass(this)) {}
+
+// Per-thread stack of held lock classes with their acquisition sites. Only
+// the return address is kept here; a full stack is captured when an
+// acquisition produces a new dependency.
+struct HeldLocks {
+    int classes[MAX_HELD];
+    void* sites[MAX_HELD];
+    int depth = 0;
+};
+thread_local HeldLocks heldLocks;
+
+// Drop-in std::mutex replacement that feeds the lock-class graph.
+class TrackedMutex {
+public:
+    explicit TrackedMutex(LockClass& cls) : cls(cls) {}
+
+    __attribute__((noinline)) void lock() {
+        acquireHook(__builtin_return_address(0));
+        m.lock();
+    }
+
+    __attribute__((noinline)) bool try_lock() {
+        // A successful trylock cannot block, so it adds no dependency
+        if (!m.try_lock()) return false;
+        pushHeld(__builtin_return_address(0));
+        return true;
+    }
+
+    void unlock() {
+        releaseHook();
+        m.unlock();
+    }
+
+private:
+    void acquireHook(void* site) {
+        LockGraph& graph = LockGraph::instance();
+        for (int i = 0; i < heldLocks.depth; ++i) {
+            graph.addDependency(heldLocks.classes[i], cls.id, heldLocks.sites[i]);
+        }
+        pushHeld(site);
+    }
+
+    void pushHeld(void* site) {
+        if (heldLocks.depth == MAX_HELD) return;
+        int d = heldLocks.depth++;
+        heldLocks.classes[d] = cls.id;
+        heldLocks.sites[d] = site;
+    }
+
+    void releaseHook() {
+        // Locks are usually released in LIFO order; search from the top
+        for (int i = heldLocks.depth - 1; i >= 0; --i) {
+            if (heldLocks.classes[i] == cls.id) {
+                for (int j = i; j + 1 < heldLocks.depth; ++j) {
+                    heldLocks.classes[j] = heldLocks.classes[j + 1];
+                    heldLocks.sites[j] = heldLocks.sites[j + 1];
+                }
+                heldLocks.depth--;
+                return;
+            }
+        }
+    }
+
+    LockClass& cls;
+    std::mutex m;
+};
+
+LockClass accountClass("account_lock");
+LockClass ledgerClass("ledger_lock");
+LockClass auditClass("audit_lock");
+
+TrackedMutex accountLock(accountClass);
+TrackedMutex ledgerLock(ledgerClass);
+TrackedMutex auditLock(auditClass);
+
+void transfer() {
+    std::lock_guard<TrackedMutex> a(accountLock);
+    std::lock_guard<TrackedMutex> l(ledgerLock);
+}
+
+void writeAudit() {
+    std::lock_guard<TrackedMutex> l(ledgerLock);
+    std::lock_guard<TrackedMutex> au(auditLock);
+}
+
+void reconcile() {
+    std::lock_guard<TrackedMutex> au(auditLock);
+    std::lock_guard<TrackedMutex> a(accountLock); // audit -> account closes the cycle
+}
+
+int main() {
+    std::cout << "--- Lockdep-Style Lock-Order Cycle Detection ---" << std::endl;
+
+    // Example: three code paths that never deadlock in this run, but whose
+    // combined lock order account -> ledger -> audit -> account can.
+    std::cout << "\n--- Test Case: Lock Order Inversion ---" << std::endl;
+    std::thread t1(transfer);
+    t1.join();
+    std::thread t2(writeAudit);
+    t2.join();
+    reconcile();
+
+    LockGraph& graph = LockGraph::instance();
+    std::cout << "\nDependencies recorded: " << graph.newEdgeCount()
+              << ", violations: " << graph.violationCount() << std::endl;
+
+    // Hot path: repeated acquisitions of an already-known lock order
+    std::cout << "\n--- Throughput: Known-Edge Hot Path ---" << std::endl;
+    const int iterations = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        transfer();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Nested lock/unlock pairs: " << iterations << ", "
+              << elapsed / iterations << " ns per pair" << std::endl;
+    std::cout << "Dependencies recorded: " << graph.newEdgeCount() << std::endl;
+
+    return 0;
+}
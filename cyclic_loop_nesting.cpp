@@ -0,0 +1,261 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <utility>
+#include <string>
+
+// Loop-nesting forest for control-flow graphs (Havlak's algorithm).
+//
+// Instead of a yes/no cycle answer, every loop of the CFG is reported with its
+// header, the blocks it directly contains, its parent loop and whether it is
+// reducible. Blocks are processed in reverse DFS preorder; each header pulls
+// in the blocks that reach its back edges, and union-find collapses finished
+// inner loops into their header so outer loops walk each of them as a single
+// node. Entries into a loop body that bypass the header make the loop
+// irreducible; those predecessors are forwarded to the header (deduplicated
+// per header) rather than re-walked, which keeps the pass near-linear.
+
+struct CSRGraph {
+    std::vector<int> offsets; // size numVertices + 1
+    std::vector<int> targets;
+
+    int numVertices() const { return static_cast<int>(offsets.size()) - 1; }
+
+    static CSRGraph fromEdges(int n, const std::vector<std::pair<int, int>>& edges) {
+        CSRGraph g;
+        g.offsets.assign(n + 1, 0);
+        for (const auto& e : edges) g.offsets[e.first + 1]++;
+        std::partial_sum(g.offsets.begin(), g.offsets.end(), g.offsets.begin());
+        g.targets.resize(edges.size());
+        std::vector<int> fill(g.offsets.begin(), g.offsets.end() - 1);
+        for (const auto& e : edges) g.targets[fill[e.first]++] = e.second;
+        return g;
+    }
+
+    CSRGraph transpose() const {
+        std::vector<std::pair<int, int>> reversed;
+        reversed.reserve(targets.size());
+        for (int u = 0; u < numVertices(); ++u) {
+            for (int i = offsets[u]; i < offsets[u + 1]; ++i) reversed.push_back({targets[i], u});
+        }
+        return fromEdges(numVertices(), reversed);
+    }
+};
+
+struct Loop {
+    int header;
+    int parent = -1;              // index of enclosing loop, -1 for top level
+    int depth = 1;
+    bool reducible = true;
+    bool selfLoop = false;        // header only, with an edge to itself
+    std::vector<int> blocks;      // blocks directly in this loop (header first)
+    std::vector<int> children;    // directly nested loops
+};
+
+struct LoopForest {
+    std::vector<Loop> loops;
+    std::vector<int> loopOf;      // innermost loop of each block, -1 if none
+};
+
+LoopForest findLoops(const CSRGraph& cfg, int entry) {
+    int n = cfg.numVertices();
+    LoopForest forest;
+    forest.loopOf.assign(n, -1);
+    if (n == 0) return forest;
+
+    CSRGraph preds = cfg.transpose();
+
+    // Iterative DFS: preorder numbers and the last descendant of each node
+    std::vector<int> number(n, -1), node, last;
+    std::vector<std::pair<int, int>> stack{{entry, cfg.offsets[entry]}};
+    number[entry] = 0;
+    node.push_back(entry);
+    last.push_back(0);
+    while (!stack.empty()) {
+        auto& [u, next] = stack.back();
+        if (next < cfg.offsets[u + 1]) {
+            int v = cfg.targets[next++];
+            if (number[v] == -1) {
+                number[v] = node.size();
+                node.push_back(v);
+                last.push_back(0);
+                stack.push_back({v, cfg.offsets[v]});
+            }
+        } else {
+            last[number[u]] = node.size() - 1;
+            stack.pop_back();
+        }
+    }
+    int reached = node.size();
+    auto isAncestor = [&](int w, int v) { return w <= v && v <= last[w]; };
+
+    // Split predecessors into back-edge and other predecessors (preorder ids)
+    std::vector<std::vector<int>> backPreds(reached), nonBackPreds(reached);
+    for (int w = 0; w < reached; ++w) {
+        int b = node[w];
+        for (int i = preds.offsets[b]; i < preds.offsets[b + 1]; ++i) {
+            int v = number[preds.targets[i]];
+            if (v == -1) continue; // unreachable predecessor
+            (isAncestor(w, v) ? backPreds[w] : nonBackPreds[w]).push_back(v);
+        }
+    }
+
+    // Union-find over preorder ids; every set is represented by its header
+    std::vector<int> uf(reached);
+    std::iota(uf.begin(), uf.end(), 0);
+    auto find = [&](int x) {
+        int root = x;
+        while (uf[root] != root) root = uf[root];
+        while (uf[x] != root) {
+            int up = uf[x];
+            uf[x] = root;
+            x = up;
+        }
+        return root;
+    };
+
+    std::vector<int> loopOfHeader(reached, -1);
+    std::vector<int> inPool(reached, -1), forwarded(reached, -1);
+    std::vector<int> nodePool, workList;
+
+    for (int w = reached - 1; w >= 0; --w) {
+        nodePool.clear();
+        bool selfLoop = false, reducible = true;
+        for (int v : backPreds[w]) {
+            if (v == w) {
+                selfLoop = true;
+                continue;
+            }
+            int x = find(v);
+            if (inPool[x] != w) {
+                inPool[x] = w;
+                nodePool.push_back(x);
+            }
+        }
+
+        workList = nodePool;
+        while (!workList.empty()) {
+            int x = workList.back();
+            workList.pop_back();
+            for (size_t i = 0; i < nonBackPreds[x].size(); ++i) {
+                int y = find(nonBackPreds[x][i]);
+                if (!isAncestor(w, y)) {
+                    // Entry into the body that bypasses the header
+                    reducible = false;
+                    if (forwarded[y] != w) {
+                        forwarded[y] = w;
+                        nonBackPreds[w].push_back(y);
+                    }
+                } else if (y != w && inPool[y] != w) {
+                    inPool[y] = w;
+                    nodePool.push_back(y);
+                    workList.push_back(y);
+                }
+            }
+        }
+
+        if (nodePool.empty() && !selfLoop) continue;
+
+        int id = forest.loops.size();
+        forest.loops.emplace_back();
+        Loop& loop = forest.loops.back();
+        loop.header = node[w];
+        loop.reducible = reducible;
+        loop.selfLoop = selfLoop && nodePool.empty();
+        loop.blocks.push_back(node[w]);
+        loopOfHeader[w] = id;
+        for (int x : nodePool) {
+            uf[x] = w;
+            if (loopOfHeader[x] != -1) {
+                forest.loops[loopOfHeader[x]].parent = id;
+                loop.children.push_back(loopOfHeader[x]);
+            } else {
+                loop.blocks.push_back(node[x]);
+            }
+        }
+    }
+
+    // Innermost loop of each block, then depths from the outermost loops down
+    for (int id = 0; id < static_cast<int>(forest.loops.size()); ++id) {
+        for (int b : forest.loops[id].blocks) forest.loopOf[b] = id;
+    }
+    for (int id = static_cast<int>(forest.loops.size()) - 1; id >= 0; --id) {
+        Loop& loop = forest.loops[id];
+        if (loop.parent != -1) loop.depth = forest.loops[loop.parent].depth + 1;
+    }
+    return forest;
+}
+
+void printLoop(const LoopForest& forest, int id) {
+    const Loop& loop = forest.loops[id];
+    std::cout << std::string(2 * (loop.depth - 1), ' ') << "Loop header " << loop.header
+              << (loop.reducible ? "" : " (IRREDUCIBLE)") << ", depth " << loop.depth << ", blocks: ";
+    for (size_t i = 0; i < loop.blocks.size(); ++i) {
+        std::cout << loop.blocks[i] << (i == loop.blocks.size() - 1 ? "" : " ");
+    }
+    std::cout << std::endl;
+    for (int child : loop.children) printLoop(forest, child);
+}
+
+void printLoops(const LoopForest& forest) {
+    if (forest.loops.empty()) {
+        std::cout << "No loops (CFG is acyclic)." << std::endl;
+        return;
+    }
+    for (int id = static_cast<int>(forest.loops.size()) - 1; id >= 0; --id) {
+        if (forest.loops[id].parent == -1) printLoop(forest, id);
+    }
+}
+
+int main() {
+    std::cout << "--- Loop-Nesting Forest (Havlak) ---" << std::endl;
+
+    // Example: nested reducible loops
+    // 0 -> 1, 1 -> 2, 2 -> 3, 3 -> 2 (inner), 3 -> 4, 4 -> 1 (outer), 4 -> 5
+    std::cout << "\n--- Test Case: Nested Loops ---" << std::endl;
+    CSRGraph nested = CSRGraph::fromEdges(6, {{0, 1}, {1, 2}, {2, 3}, {3, 2}, {3, 4}, {4, 1}, {4, 5}});
+    printLoops(findLoops(nested, 0));
+
+    // Example: irreducible loop, 1 and 2 both entered from 0
+    std::cout << "\n--- Test Case: Irreducible Loop ---" << std::endl;
+    CSRGraph irreducible = CSRGraph::fromEdges(4, {{0, 1}, {0, 2}, {1, 2}, {2, 1}, {2, 3}});
+    printLoops(findLoops(irreducible, 0));
+
+    // Throughput: a module of random structured CFGs with some irreducible jumps
+    std::cout << "\n--- Throughput: Module of Random CFGs ---" << std::endl;
+    const int numFunctions = 20000;
+    const int blocksPerFunction = 200;
+    std::mt19937 rng(7);
+    std::vector<CSRGraph> module;
+    long long totalBlocks = 0, totalEdges = 0;
+    for (int f = 0; f < numFunctions; ++f) {
+        std::vector<std::pair<int, int>> edges;
+        for (int b = 0; b + 1 < blocksPerFunction; ++b) {
+            edges.push_back({b, b + 1});
+            int r = rng() % 100;
+            if (r < 15 && b > 0) edges.push_back({b, static_cast<int>(rng() % b)});                  // back edge
+            else if (r < 30) edges.push_back({b, b + 1 + static_cast<int>(rng() % (blocksPerFunction - b - 1))}); // forward jump
+        }
+        module.push_back(CSRGraph::fromEdges(blocksPerFunction, edges));
+        totalBlocks += blocksPerFunction;
+        totalEdges += edges.size();
+    }
+
+    long long totalLoops = 0, irreducibleLoops = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const CSRGraph& cfg : module) {
+        LoopForest forest = findLoops(cfg, 0);
+        totalLoops += forest.loops.size();
+        for (const Loop& loop : forest.loops) irreducibleLoops += !loop.reducible;
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Functions: " << numFunctions << ", blocks: " << totalBlocks << ", edges: " << totalEdges << std::endl;
+    std::cout << "Loops: " << totalLoops << " (" << irreducibleLoops << " irreducible)" << std::endl;
+    std::cout << "Throughput: " << static_cast<long long>(totalBlocks / elapsed) << " blocks/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,321 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <stdexcept>
+
+// Cycle detection over string-named vertices.
+//
+// Names are interned into dense 32-bit ids as edges are ingested. Each
+// distinct name is copied once into an arena of large blocks; hash-table
+// slots hold the hash, the id and a pointer to the arena copy, so a probe
+// costs one slot access plus one arena access. The id -> name map is an
+// array of string_views into the arena. Edges are collected as id pairs and
+// turned into CSR with a counting pass, and witness cycles come back as views
+// of the interned names without copying them.
+
+// Names are stored with a 16-bit length prefix (so at most 65535 bytes each;
+// longer names are rejected) and a hash-table probe can compare a candidate
+// without touching any other array.
+class NameArena {
+public:
+    static constexpr size_t MAX_NAME = UINT16_MAX;
+
+    const char* store(std::string_view name) {
+        size_t need = name.size() + 2;
+        if (blocks.empty() || used + need > BLOCK_SIZE) {
+            blocks.emplace_back(new char[std::max(BLOCK_SIZE, need)]);
+            used = 0;
+        }
+        char* dst = blocks.back().get() + used;
+        uint16_t len = static_cast<uint16_t>(name.size());
+        std::memcpy(dst, &len, 2);
+        std::memcpy(dst + 2, name.data(), name.size());
+        used += need;
+        return dst + 2;
+    }
+
+    static std::string_view view(const char* stored) {
+        uint16_t len;
+        std::memcpy(&len, stored - 2, 2);
+        return std::string_view(stored, len);
+    }
+
+    size_t memoryBytes() const { return blocks.size() * BLOCK_SIZE; }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t used = 0;
+};
+
+class NameInterner {
+public:
+    explicit NameInterner(size_t expectedNames = 1024) {
+        size_t cap = 16;
+        while (cap * 7 < expectedNames * 10) cap <<= 1;
+        slots.assign(cap, Slot{0, EMPTY, nullptr});
+        names.reserve(expectedNames);
+    }
+
+    uint32_t intern(std::string_view name) {
+        if (name.size() > NameArena::MAX_NAME) {
+            throw std::length_error("vertex name longer than " + std::to_string(NameArena::MAX_NAME) + " bytes");
+        }
+        if ((names.size() + 1) * 10 > slots.size() * 7) grow();
+        uint32_t h = hash(name);
+        size_t mask = slots.size() - 1;
+        for (size_t i = h & mask;; i = (i + 1) & mask) {
+            Slot& slot = slots[i];
+            if (slot.id == EMPTY) {
+                const char* stored = arena.store(name);
+                slot = {h, static_cast<uint32_t>(names.size()), stored};
+                names.push_back(std::string_view(stored, name.size()));
+                return slot.id;
+            }
+            if (slot.hash == h && NameArena::view(slot.name) == name) return slot.id;
+        }
+    }
+
+    std::string_view name(uint32_t id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+    size_t memoryBytes() const {
+        return arena.memoryBytes() + slots.size() * sizeof(Slot) + names.capacity() * sizeof(std::string_view);
+    }
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+    struct Slot {
+        uint32_t hash;
+        uint32_t id;
+        const char* name; // into the arena, length-prefixed
+    };
+
+    // FNV-1a, eight bytes at a time, then a final avalanche
+    static uint32_t hash(std::string_view s) {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        size_t i = 0;
+        for (; i + 8 <= s.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, s.data() + i, 8);
+            h = (h ^ word) * 0x100000001b3ULL;
+        }
+        for (; i < s.size(); ++i) h = (h ^ static_cast<unsigned char>(s[i])) * 0x100000001b3ULL;
+        h ^= h >> 29;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 32;
+        return static_cast<uint32_t>(h);
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots.size() * 2, Slot{0, EMPTY, nullptr});
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (const Slot& s : old) {
+            if (s.id == EMPTY) continue;
+            size_t i = s.hash & mask;
+            while (slots[i].id != EMPTY) i = (i + 1) & mask;
+            slots[i] = s;
+        }
+    }
+
+    NameArena arena;
+    std::vector<Slot> slots;
+    std::vector<std::string_view> names;
+};
+
+class NamedGraph {
+public:
+    explicit NamedGraph(size_t expectedNames = 1024) : interner(expectedNames) {}
+
+    void addEdge(std::string_view from, std::string_view to) {
+        uint32_t u = interner.intern(from);
+        uint32_t v = interner.intern(to);
+        edges.push_back({u, v});
+    }
+
+    // Parse "from to" lines (whitespace separated, LF or CRLF) from a text
+    // buffer. Blank lines are skipped; any other line must hold exactly two
+    // names.
+    void ingest(std::string_view text) {
+        auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+        size_t pos = 0, lineNumber = 1;
+        while (pos < text.size()) {
+            std::string_view from, to;
+            int count = 0;
+            while (true) {
+                while (pos < text.size() && isSpace(text[pos])) pos++;
+                if (pos == text.size() || text[pos] == '\n') break;
+                size_t start = pos;
+                while (pos < text.size() && !isSpace(text[pos]) && text[pos] != '\n') pos++;
+                (count == 0 ? from : to) = text.substr(start, pos - start);
+                if (++count > 2) break;
+            }
+            if (count == 2) {
+                addEdge(from, to);
+            } else if (count != 0) {
+                throw std::invalid_argument("line " + std::to_string(lineNumber) + ": expected \"from to\", got " +
+                                            (count == 1 ? "one name" : "more than two names"));
+            }
+            pos++; // the newline
+            lineNumber++;
+        }
+    }
+
+    // Counting-sort the collected edges into CSR.
+    void buildCSR() {
+        uint32_t n = interner.size();
+        offsets.assign(n + 1, 0);
+        for (const auto& e : edges) offsets[e.first + 1]++;
+        for (uint32_t i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+        targets.resize(edges.size());
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& e : edges) targets[fill[e.first]++] = e.second;
+        std::vector<std::pair<uint32_t, uint32_t>>().swap(edges);
+    }
+
+    // Iterative DFS with the recursion-stack check of `dfs`; returns the
+    // cycle as views of the interned names.
+    std::vector<std::string_view> findCycle() const {
+        uint32_t n = interner.size();
+        std::vector<uint8_t> state(n, 0); // 0 = unvisited, 1 = on stack, 2 = done
+        std::vector<std::pair<uint32_t, uint32_t>> stack; // vertex, next edge
+        for (uint32_t root = 0; root < n; ++root) {
+            if (state[root] != 0) continue;
+            stack.push_back({root, offsets[root]});
+            state[root] = 1;
+            while (!stack.empty()) {
+                auto& [u, next] = stack.back();
+                if (next == offsets[u + 1]) {
+                    state[u] = 2;
+                    stack.pop_back();
+                    continue;
+                }
+                uint32_t v = targets[next++];
+                if (state[v] == 0) {
+                    state[v] = 1;
+                    stack.push_back({v, offsets[v]});
+                } else if (state[v] == 1) {
+                    size_t k = stack.size();
+                    while (stack[k - 1].first != v) --k;
+                    std::vector<std::string_view> cycle;
+                    for (size_t i = k - 1; i < stack.size(); ++i) cycle.push_back(interner.name(stack[i].first));
+                    return cycle;
+                }
+            }
+        }
+        return {};
+    }
+
+    size_t numVertices() const { return interner.size(); }
+    size_t numEdges() const { return targets.size(); }
+    const NameInterner& names() const { return interner; }
+
+private:
+    NameInterner interner;
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    std::vector<uint32_t> offsets, targets;
+};
+
+void printCycle(const std::vector<std::string_view>& cycle) {
+    if (cycle.empty()) {
+        std::cout << "No cycle found." << std::endl;
+        return;
+    }
+    std::cout << "Cycle detected. Vertices in cycle: ";
+    for (std::string_view name : cycle) std::cout << name << " -> ";
+    std::cout << cycle[0] << std::endl;
+}
+
+int main() {
+    std::cout << "--- Cycle Detection over Named Vertices ---" << std::endl;
+
+    // Example: package dependencies with a cycle through three packages
+    std::cout << "\n--- Test Case: Package Dependencies ---" << std::endl;
+    NamedGraph deps;
+    deps.ingest(
+        "app        libnet\n"
+        "app        libui\n"
+        "libnet     libssl\n"
+        "libssl     libcrypto\n"
+        "libcrypto  libnet\n"
+        "libui      libcore\n");
+    deps.buildCSR();
+    std::cout << "Vertices: " << deps.numVertices() << ", edges: " << deps.numEdges() << std::endl;
+    printCycle(deps.findCycle());
+
+    // Example: CRLF line endings do not leak into the names
+    std::cout << "\n--- Test Case: CRLF Input ---" << std::endl;
+    NamedGraph crlf;
+    crlf.ingest("a b\r\nb c\r\nc a\r\n");
+    crlf.buildCSR();
+    std::cout << "Vertices: " << crlf.numVertices() << ", edges: " << crlf.numEdges() << std::endl;
+    printCycle(crlf.findCycle());
+
+    // Example: a line with one or three names is an error, not a shifted edge
+    std::cout << "\n--- Test Case: Malformed Lines ---" << std::endl;
+    for (const char* text : {"a b\nc\nd e\n", "a b\n\nc d e\n", "a b\nc"}) {
+        NamedGraph malformed;
+        try {
+            malformed.ingest(text);
+            std::cout << "Accepted" << std::endl;
+        } catch (const std::invalid_argument& e) {
+            std::cout << "Rejected: " << e.what() << std::endl;
+        }
+    }
+
+    // Example: names that do not fit the 16-bit length prefix are rejected
+    std::cout << "\n--- Test Case: Over-Long Name ---" << std::endl;
+    NamedGraph longNames;
+    try {
+        longNames.addEdge(std::string(70000, 'x') + "1", std::string(70000, 'x') + "2");
+        std::cout << "Accepted" << std::endl;
+    } catch (const std::length_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+    }
+
+    // Throughput: 10M target names, each depending on up to two earlier ones
+    std::cout << "\n--- Throughput: 10M Names ---" << std::endl;
+    const uint32_t numNames = 10000000;
+    std::string text;
+    text.reserve(static_cast<size_t>(numNames) * 2 * 40);
+    uint64_t rng = 88172645463325252ULL;
+    auto next = [&]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return rng;
+    };
+    for (uint32_t i = 1; i < numNames; ++i) {
+        for (int d = 0; d < 2; ++d) {
+            text += "//services/target_";
+            text += std::to_string(i);
+            text += " //services/target_";
+            text += std::to_string(next() % i);
+            text += '\n';
+        }
+    }
+    text += "//services/target_0 //services/target_9999999\n"; // close a long cycle
+
+    auto start = std::chrono::steady_clock::now();
+    NamedGraph big(numNames);
+    big.ingest(text);
+    double ingestSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    big.buildCSR();
+    std::vector<std::string_view> cycle = big.findCycle();
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Names: " << big.numVertices() << ", edges: " << big.numEdges()
+              << ", interner memory: " << (big.names().memoryBytes() >> 20) << " MB" << std::endl;
+    std::cout << "Ingest: " << ingestSeconds << " s ("
+              << static_cast<long long>(big.numVertices() / ingestSeconds) << " names/s), total with CSR and DFS: "
+              << totalSeconds << " s" << std::endl;
+    std::cout << "Cycle length: " << cycle.size() << ", starting at " << (cycle.empty() ? "-" : cycle[0]) << std::endl;
+
+    return 0;
+}
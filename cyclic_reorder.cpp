@@ -0,0 +1,333 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+// Cache-locality reordering before cycle detection.
+//
+// Kahn's algorithm and DFS touch vertices in the order edges lead to them.
+// When vertex ids carry no locality, each neighbor access lands on an
+// unrelated cache line of `inDegree` / `state` and of the CSR offsets. A
+// reordering pass computes a permutation that places vertices reached from
+// each other next to each other, relabels the CSR, runs detection on the
+// relabeled graph and maps the witness cycle back to the input ids:
+//   - DEGREE:  descending total degree (hubs share cache lines),
+//   - RCM:     reverse Cuthill-McKee over the undirected view (bandwidth),
+//   - COMMUNITY: label propagation to find clusters, then BFS order inside
+//              each cluster (the idea behind Rabbit order, in a lighter form).
+//
+// The orderings are not free: on the clustered benchmark in main each one
+// costs several detection passes, so a single check is slower end to end
+// (net 0.1-0.3x) and only the community order speeds up detection itself
+// noticeably. Reordering pays off only when the relabeled graph is checked
+// many times.
+
+struct CSRGraph {
+    std::vector<uint32_t> offsets, targets;
+
+    uint32_t numVertices() const { return offsets.size() - 1; }
+
+    static CSRGraph fromEdges(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+        CSRGraph g;
+        g.offsets.assign(n + 1, 0);
+        for (const auto& e : edges) g.offsets[e.first + 1]++;
+        for (uint32_t i = 0; i < n; ++i) g.offsets[i + 1] += g.offsets[i];
+        g.targets.resize(edges.size());
+        std::vector<uint32_t> fill(g.offsets.begin(), g.offsets.end() - 1);
+        for (const auto& e : edges) g.targets[fill[e.first]++] = e.second;
+        return g;
+    }
+
+    // Out- and in-neighbors merged, for orderings that ignore direction
+    CSRGraph undirected() const {
+        uint32_t n = numVertices();
+        CSRGraph u;
+        u.offsets.assign(n + 1, 0);
+        for (uint32_t v = 0; v < n; ++v) {
+            u.offsets[v + 1] += offsets[v + 1] - offsets[v];
+            for (uint32_t i = offsets[v]; i < offsets[v + 1]; ++i) u.offsets[targets[i] + 1]++;
+        }
+        for (uint32_t i = 0; i < n; ++i) u.offsets[i + 1] += u.offsets[i];
+        u.targets.resize(2 * targets.size());
+        std::vector<uint32_t> fill(u.offsets.begin(), u.offsets.end() - 1);
+        for (uint32_t v = 0; v < n; ++v) {
+            for (uint32_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+                u.targets[fill[v]++] = targets[i];
+                u.targets[fill[targets[i]]++] = v;
+            }
+        }
+        return u;
+    }
+};
+
+enum class Ordering { DEGREE, RCM, COMMUNITY };
+
+const char* orderingName(Ordering o) {
+    switch (o) {
+        case Ordering::DEGREE: return "degree";
+        case Ordering::RCM: return "RCM";
+        default: return "community";
+    }
+}
+
+// Each ordering returns `order`, the list of old ids in their new positions.
+std::vector<uint32_t> degreeOrder(const CSRGraph& undirected) {
+    uint32_t n = undirected.numVertices();
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    auto degree = [&](uint32_t v) { return undirected.offsets[v + 1] - undirected.offsets[v]; };
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return degree(a) > degree(b); });
+    return order;
+}
+
+std::vector<uint32_t> rcmOrder(const CSRGraph& undirected) {
+    uint32_t n = undirected.numVertices();
+    auto degree = [&](uint32_t v) { return undirected.offsets[v + 1] - undirected.offsets[v]; };
+
+    // Components are started from low-degree vertices (peripheral ones)
+    std::vector<uint32_t> byDegree(n);
+    std::iota(byDegree.begin(), byDegree.end(), 0);
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&](uint32_t a, uint32_t b) { return degree(a) < degree(b); });
+
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    std::vector<bool> placed(n, false);
+    std::vector<uint32_t> neighbors;
+    for (uint32_t root : byDegree) {
+        if (placed[root]) continue;
+        placed[root] = true;
+        order.push_back(root);
+        for (size_t head = order.size() - 1; head < order.size(); ++head) {
+            uint32_t u = order[head];
+            neighbors.clear();
+            for (uint32_t i = undirected.offsets[u]; i < undirected.offsets[u + 1]; ++i) {
+                uint32_t v = undirected.targets[i];
+                if (!placed[v]) {
+                    placed[v] = true;
+                    neighbors.push_back(v);
+                }
+            }
+            std::sort(neighbors.begin(), neighbors.end(), [&](uint32_t a, uint32_t b) { return degree(a) < degree(b); });
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<uint32_t> communityOrder(const CSRGraph& undirected, int rounds = 3) {
+    uint32_t n = undirected.numVertices();
+    std::vector<uint32_t> label(n);
+    std::iota(label.begin(), label.end(), 0);
+
+    // Label propagation: adopt the most frequent neighbor label (ties to the
+    // smaller label). Neighbor labels are counted in a scratch buffer.
+    std::vector<uint32_t> seen;
+    for (int r = 0; r < rounds; ++r) {
+        for (uint32_t v = 0; v < n; ++v) {
+            seen.clear();
+            for (uint32_t i = undirected.offsets[v]; i < undirected.offsets[v + 1]; ++i) {
+                seen.push_back(label[undirected.targets[i]]);
+            }
+            if (seen.empty()) continue;
+            std::sort(seen.begin(), seen.end());
+            uint32_t best = seen[0], bestCount = 0;
+            for (size_t i = 0; i < seen.size();) {
+                size_t j = i;
+                while (j < seen.size() && seen[j] == seen[i]) ++j;
+                if (j - i > bestCount) {
+                    best = seen[i];
+                    bestCount = j - i;
+                }
+                i = j;
+            }
+            label[v] = best;
+        }
+    }
+
+    // Group by label, then BFS inside each group from its first member
+    std::vector<uint32_t> groupStart(n + 1, 0);
+    for (uint32_t v = 0; v < n; ++v) groupStart[label[v] + 1]++;
+    for (uint32_t i = 0; i < n; ++i) groupStart[i + 1] += groupStart[i];
+    std::vector<uint32_t> members(n);
+    std::vector<uint32_t> fill(groupStart.begin(), groupStart.end() - 1);
+    for (uint32_t v = 0; v < n; ++v) members[fill[label[v]]++] = v;
+
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    std::vector<bool> placed(n, false);
+    for (uint32_t m : members) {
+        if (placed[m]) continue;
+        placed[m] = true;
+        order.push_back(m);
+        for (size_t head = order.size() - 1; head < order.size(); ++head) {
+            uint32_t u = order[head];
+            for (uint32_t i = undirected.offsets[u]; i < undirected.offsets[u + 1]; ++i) {
+                uint32_t v = undirected.targets[i];
+                if (!placed[v] && label[v] == label[m]) {
+                    placed[v] = true;
+                    order.push_back(v);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+std::vector<uint32_t> computeOrder(const CSRGraph& g, Ordering ordering) {
+    CSRGraph u = g.undirected();
+    switch (ordering) {
+        case Ordering::DEGREE: return degreeOrder(u);
+        case Ordering::RCM: return rcmOrder(u);
+        default: return communityOrder(u);
+    }
+}
+
+// Relabel so that order[k] becomes vertex k; neighbor lists are sorted so
+// consecutive targets are also close in memory.
+CSRGraph relabel(const CSRGraph& g, const std::vector<uint32_t>& order) {
+    uint32_t n = g.numVertices();
+    std::vector<uint32_t> newId(n);
+    for (uint32_t k = 0; k < n; ++k) newId[order[k]] = k;
+
+    CSRGraph r;
+    r.offsets.assign(n + 1, 0);
+    for (uint32_t k = 0; k < n; ++k) r.offsets[k + 1] = r.offsets[k] + (g.offsets[order[k] + 1] - g.offsets[order[k]]);
+    r.targets.resize(g.targets.size());
+    for (uint32_t k = 0; k < n; ++k) {
+        uint32_t out = r.offsets[k];
+        for (uint32_t i = g.offsets[order[k]]; i < g.offsets[order[k] + 1]; ++i) r.targets[out++] = newId[g.targets[i]];
+        std::sort(r.targets.begin() + r.offsets[k], r.targets.begin() + out);
+    }
+    return r;
+}
+
+// Kahn's algorithm; if vertices remain, a DFS over them returns a cycle.
+std::vector<uint32_t> detectCycleCSR(const CSRGraph& g) {
+    uint32_t n = g.numVertices();
+    std::vector<uint32_t> inDegree(n, 0);
+    for (uint32_t t : g.targets) inDegree[t]++;
+
+    std::vector<uint32_t> queue;
+    queue.reserve(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (inDegree[v] == 0) queue.push_back(v);
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        uint32_t u = queue[head];
+        for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            if (--inDegree[g.targets[i]] == 0) queue.push_back(g.targets[i]);
+        }
+    }
+    if (queue.size() == n) return {};
+
+    std::vector<uint8_t> state(n, 0); // 0 = unvisited, 1 = on stack, 2 = done
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    for (uint32_t root = 0; root < n; ++root) {
+        if (inDegree[root] == 0 || state[root] != 0) continue;
+        stack.push_back({root, g.offsets[root]});
+        state[root] = 1;
+        while (!stack.empty()) {
+            auto& [u, next] = stack.back();
+            if (next == g.offsets[u + 1]) {
+                state[u] = 2;
+                stack.pop_back();
+                continue;
+            }
+            uint32_t v = g.targets[next++];
+            if (state[v] == 1) {
+                size_t k = stack.size();
+                while (stack[k - 1].first != v) --k;
+                std::vector<uint32_t> cycle;
+                for (size_t i = k - 1; i < stack.size(); ++i) cycle.push_back(stack[i].first);
+                return cycle;
+            }
+            if (state[v] == 0 && inDegree[v] > 0) {
+                state[v] = 1;
+                stack.push_back({v, g.offsets[v]});
+            }
+        }
+    }
+    return {};
+}
+
+// Reorder, detect on the relabeled graph, and report the cycle in input ids.
+std::vector<uint32_t> detectCycleReordered(const CSRGraph& g, Ordering ordering) {
+    std::vector<uint32_t> order = computeOrder(g, ordering);
+    std::vector<uint32_t> cycle = detectCycleCSR(relabel(g, order));
+    for (uint32_t& v : cycle) v = order[v];
+    return cycle;
+}
+
+void printCycle(const std::vector<uint32_t>& cycle) {
+    if (cycle.empty()) {
+        std::cout << "Result: Graph is ACYCLIC." << std::endl;
+        return;
+    }
+    std::cout << "Result: Graph is CYCLIC. Vertices in a cycle: ";
+    for (uint32_t v : cycle) std::cout << v << " -> ";
+    std::cout << cycle[0] << std::endl;
+}
+
+int main() {
+    std::cout << "--- Cycle Detection with Locality Reordering ---" << std::endl;
+    const Ordering orderings[] = {Ordering::DEGREE, Ordering::RCM, Ordering::COMMUNITY};
+
+    // Example: the 4-vertex test case; cycles come back in input ids
+    std::cout << "\n--- Test Case: Cyclic Graph ---" << std::endl;
+    CSRGraph small = CSRGraph::fromEdges(4, {{0, 1}, {1, 2}, {1, 3}, {3, 1}});
+    for (Ordering o : orderings) {
+        std::cout << orderingName(o) << ": ";
+        printCycle(detectCycleReordered(small, o));
+    }
+
+    // Throughput: clusters of 64 vertices with edges inside the cluster and a
+    // few to later clusters, all forward (a DAG), under a random numbering
+    std::cout << "\n--- Throughput: 4M Vertices, Randomly Numbered Clusters ---" << std::endl;
+    const uint32_t n = 1 << 22, clusterSize = 64;
+    std::mt19937 rng(3);
+    std::vector<uint32_t> shuffle(n);
+    std::iota(shuffle.begin(), shuffle.end(), 0);
+    std::shuffle(shuffle.begin(), shuffle.end(), rng);
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(static_cast<size_t>(n) * 8);
+    for (uint32_t v = 0; v < n; ++v) {
+        uint32_t base = v - v % clusterSize;
+        for (int d = 0; d < 7; ++d) {
+            uint32_t w = base + rng() % clusterSize;
+            if (w > v) edges.push_back({shuffle[v], shuffle[w]});
+        }
+        if (v + clusterSize < n) edges.push_back({shuffle[v], shuffle[v + clusterSize + rng() % (n - v - clusterSize)]});
+    }
+    CSRGraph big = CSRGraph::fromEdges(n, edges);
+    std::vector<std::pair<uint32_t, uint32_t>>().swap(edges);
+    std::cout << "Vertices: " << n << ", edges: " << big.targets.size() << std::endl;
+
+    auto seconds = [](auto start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> cycle = detectCycleCSR(big);
+    double baseline = seconds(start);
+    std::cout << "input order: detect " << baseline << " s, cycle: " << (cycle.empty() ? "none" : "found") << std::endl;
+
+    for (Ordering o : orderings) {
+        start = std::chrono::steady_clock::now();
+        std::vector<uint32_t> order = computeOrder(big, o);
+        CSRGraph reordered = relabel(big, order);
+        double reorderSeconds = seconds(start);
+        start = std::chrono::steady_clock::now();
+        cycle = detectCycleCSR(reordered);
+        double detectSeconds = seconds(start);
+        // Net speedup counts the reordering: a single check pays for it in full
+        std::cout << orderingName(o) << ": reorder " << reorderSeconds << " s, detect " << detectSeconds
+                  << " s, net speedup " << baseline / (reorderSeconds + detectSeconds) << "x (detection alone "
+                  << baseline / detectSeconds << "x), cycle: " << (cycle.empty() ? "none" : "found") << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,322 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <stdexcept>
+#include <filesystem>
+#include <cstdio>
+#include <cstdint>
+#include <sys/wait.h>
+
+// Acyclicity check over an edge stream in a bounded number of sequential
+// passes with O(V) memory.
+//
+// Edges are never stored: each pass re-reads the stream from the start
+// (a file, or a command whose output is piped in again). The stream is a
+// sequence of binary (uint32 from, uint32 to) pairs. Every pass must see the
+// same edges: a failing source, a read error, a trailing partial record or
+// an edge count differing from pass 0 aborts the check.
+//
+//   Pass 0 counts in-degrees and the number of vertices.
+//   Every following pass peels: an edge (u, v) whose source u is already
+//   removed decrements v, and v is removed as soon as its count reaches
+//   zero, so one pass can peel many levels when the stream order is
+//   favorable (a topologically ordered log finishes in a single peeling
+//   pass). An edge must be counted exactly once, so each vertex remembers
+//   the pass and stream position at which it was removed: an edge counts
+//   in the removal pass if it comes after that position, and in the next
+//   pass if it came before. A pass that removes nothing therefore leaves no
+//   edge of a removed vertex uncounted and ends the peeling; random stream
+//   orders need about one pass per level of the DAG. If vertices remain, each
+//   of them still has a remaining predecessor; one more pass records one
+//   such predecessor per vertex, and walking those links from any remaining
+//   vertex must repeat a vertex, which yields a cycle.
+//
+// Memory is 16 bytes per vertex (in-degree, removal pass, removal position)
+// plus the stream buffer, independent of the number of edges.
+
+// close() throws if the source failed to produce its stream
+class EdgeSource {
+public:
+    virtual ~EdgeSource() = default;
+    virtual FILE* open() = 0;
+    virtual void close(FILE* f) = 0;
+};
+
+class FileEdgeSource : public EdgeSource {
+public:
+    explicit FileEdgeSource(std::string path) : path(std::move(path)) {}
+    FILE* open() override { return std::fopen(path.c_str(), "rb"); }
+    void close(FILE* f) override {
+        if (std::fclose(f) != 0) throw std::runtime_error("cannot close " + path);
+    }
+
+private:
+    std::string path;
+};
+
+// Re-runs a shell command for every pass and reads its standard output
+class CommandEdgeSource : public EdgeSource {
+public:
+    explicit CommandEdgeSource(std::string command) : command(std::move(command)) {}
+    FILE* open() override { return popen(command.c_str(), "r"); }
+    void close(FILE* f) override {
+        int status = pclose(f);
+        if (status == -1) throw std::runtime_error("cannot close command: " + command);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::string why = WIFEXITED(status) ? "exit status " + std::to_string(WEXITSTATUS(status))
+                                                : "signal " + std::to_string(WTERMSIG(status));
+            throw std::runtime_error("command failed (" + why + "): " + command);
+        }
+    }
+
+private:
+    std::string command;
+};
+
+struct SemiStreamingResult {
+    enum Verdict { ACYCLIC, CYCLIC, UNDECIDED } verdict = UNDECIDED;
+    std::vector<uint32_t> cycle;
+    uint32_t numVertices = 0, remaining = 0;
+    uint64_t numEdges = 0;
+    int passes = 0;
+    size_t memoryBytes = 0;
+};
+
+class SemiStreamingChecker {
+public:
+    explicit SemiStreamingChecker(EdgeSource& source, int maxPasses = 64) : source(source), maxPasses(maxPasses) {}
+
+    SemiStreamingResult run() {
+        SemiStreamingResult result;
+
+        // Pass 0: in-degrees; the vertex count grows with the largest id seen
+        result.numEdges = stream([&](uint64_t, uint32_t u, uint32_t v) {
+            uint32_t high = std::max(u, v);
+            if (high >= inDegree.size()) inDegree.resize(static_cast<size_t>(high) + 1, 0);
+            inDegree[v]++;
+        });
+        result.passes = 1;
+        uint32_t n = inDegree.size();
+        result.numVertices = n;
+        removedPass.assign(n, NOT_REMOVED);
+        removedAt.assign(n, 0);
+
+        // Sources count as removed at the very start of the first peeling pass
+        uint32_t remaining = n;
+        for (uint32_t v = 0; v < n; ++v) {
+            if (inDegree[v] == 0) {
+                removedPass[v] = 1;
+                remaining--;
+            }
+        }
+
+        for (uint32_t pass = 1; remaining > 0; ++pass) {
+            if (result.passes == maxPasses) {
+                result.remaining = remaining;
+                result.memoryBytes = memoryBytes();
+                return result; // UNDECIDED
+            }
+            uint32_t removedThisPass = 0;
+            stream(result.numEdges, [&](uint64_t position, uint32_t u, uint32_t v) {
+                if (!counts(u, pass, position)) return;
+                if (--inDegree[v] == 0) {
+                    removedPass[v] = pass;
+                    removedAt[v] = position + 1;
+                    removedThisPass++;
+                }
+            });
+            result.passes++;
+            remaining -= removedThisPass;
+            // Every edge of a vertex removed before this pass has now been
+            // counted, so a pass without removals is a fixpoint
+            if (removedThisPass == 0) break;
+        }
+        result.remaining = remaining;
+        result.memoryBytes = memoryBytes();
+        if (remaining == 0) {
+            result.verdict = SemiStreamingResult::ACYCLIC;
+            return result;
+        }
+
+        // Witness pass: one remaining predecessor per remaining vertex
+        std::vector<uint32_t>& parent = inDegree; // counts are no longer needed
+        const uint32_t NONE = UINT32_MAX;
+        for (uint32_t v = 0; v < n; ++v) parent[v] = NONE;
+        stream(result.numEdges, [&](uint64_t, uint32_t u, uint32_t v) {
+            if (removedPass[u] == NOT_REMOVED && removedPass[v] == NOT_REMOVED && parent[v] == NONE) parent[v] = u;
+        });
+        result.passes++;
+
+        uint32_t current = 0;
+        while (removedPass[current] != NOT_REMOVED) ++current;
+        // After `remaining` steps the walk is on a cycle; collect it
+        for (uint32_t i = 0; i < remaining; ++i) current = parent[current];
+        uint32_t start = current;
+        do {
+            result.cycle.push_back(current);
+            current = parent[current];
+        } while (current != start);
+        std::reverse(result.cycle.begin(), result.cycle.end());
+        result.verdict = SemiStreamingResult::CYCLIC;
+        return result;
+    }
+
+private:
+    static constexpr uint32_t NOT_REMOVED = UINT32_MAX;
+
+    // Whether edge (u, ...) at `position` decrements its target in `pass`:
+    // edges from removedAt[u] on count in u's removal pass, earlier ones in
+    // the pass after it
+    bool counts(uint32_t u, uint32_t pass, uint64_t position) const {
+        uint32_t p = removedPass[u];
+        if (p == NOT_REMOVED) return false;
+        if (p == pass) return position >= removedAt[u];
+        if (p + 1 == pass) return position < removedAt[u];
+        return false;
+    }
+
+    size_t memoryBytes() const {
+        return inDegree.capacity() * 4 + removedPass.capacity() * 4 + removedAt.capacity() * 8 + BUFFER_EDGES * 8;
+    }
+
+    // One sequential pass; f(position, u, v) for every edge. Returns the
+    // number of edges. Throws on a read error, a failing source or a stream
+    // ending inside a record.
+    template <class F>
+    uint64_t stream(F f) {
+        FILE* in = source.open();
+        if (!in) throw std::runtime_error("cannot open edge stream");
+        std::unique_ptr<uint32_t[]> buffer(new uint32_t[2 * BUFFER_EDGES]);
+        uint64_t position = 0;
+        size_t got;
+        do {
+            got = std::fread(buffer.get(), 1, 8 * BUFFER_EDGES, in);
+            for (size_t i = 0; i < got / 8; ++i, ++position) f(position, buffer[2 * i], buffer[2 * i + 1]);
+        } while (got == 8 * BUFFER_EDGES);
+        bool readError = std::ferror(in);
+        source.close(in);
+        if (readError) throw std::runtime_error("read error on edge stream");
+        if (got % 8 != 0) throw std::runtime_error("edge stream ends inside a record");
+        return position;
+    }
+
+    // A later pass must see exactly the edges of pass 0
+    template <class F>
+    void stream(uint64_t expectedEdges, F f) {
+        uint64_t edges = stream(f);
+        if (edges != expectedEdges) {
+            throw std::runtime_error("edge stream changed between passes: " + std::to_string(edges) + " edges, expected " +
+                                     std::to_string(expectedEdges));
+        }
+    }
+
+    static constexpr size_t BUFFER_EDGES = 1 << 20;
+    EdgeSource& source;
+    int maxPasses;
+    std::vector<uint32_t> inDegree;
+    std::vector<uint32_t> removedPass;
+    std::vector<uint64_t> removedAt;
+};
+
+void writeEdges(const std::string& path, const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    for (const auto& [u, v] : edges) {
+        uint32_t pair[2] = {u, v};
+        std::fwrite(pair, 4, 2, f);
+    }
+    std::fclose(f);
+}
+
+void printResult(const SemiStreamingResult& result) {
+    const char* verdicts[] = {"ACYCLIC", "CYCLIC", "UNDECIDED (pass limit reached)"};
+    std::cout << "Result: " << verdicts[result.verdict] << " after " << result.passes << " passes; vertices: "
+              << result.numVertices << ", edges: " << result.numEdges << ", unpeeled: " << result.remaining << std::endl;
+    if (!result.cycle.empty()) {
+        std::cout << "Vertices in a cycle: ";
+        for (uint32_t v : result.cycle) std::cout << v << " -> ";
+        std::cout << result.cycle[0] << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "--- Semi-Streaming Acyclicity Check ---" << std::endl;
+    std::string dir = std::filesystem::temp_directory_path().string();
+
+    try {
+        // Example: the 4-vertex test case, streamed through a pipe
+        std::cout << "\n--- Test Case: Cyclic Graph (piped) ---" << std::endl;
+        std::string smallPath = dir + "/cyclic_semi_small.edges";
+        writeEdges(smallPath, {{0, 1}, {1, 2}, {1, 3}, {3, 1}});
+        CommandEdgeSource piped("cat " + smallPath);
+        printResult(SemiStreamingChecker(piped).run());
+
+        // Example: broken streams are rejected instead of read as empty or
+        // truncated: a failing producer, a trailing partial record, and a
+        // stream that grows between passes
+        std::cout << "\n--- Test Case: Broken Streams ---" << std::endl;
+        CommandEdgeSource failing("cat " + dir + "/cyclic_semi_missing.edges 2>/dev/null");
+        CommandEdgeSource partial("cat " + smallPath + "; printf abcd");
+        std::string countPath = dir + "/cyclic_semi_passes";
+        std::filesystem::remove(countPath);
+        CommandEdgeSource growing("cat " + smallPath + "; if [ -e " + countPath + " ]; then cat " + smallPath + "; fi; touch " +
+                                  countPath);
+        for (EdgeSource* broken : {static_cast<EdgeSource*>(&failing), static_cast<EdgeSource*>(&partial),
+                                   static_cast<EdgeSource*>(&growing)}) {
+            try {
+                printResult(SemiStreamingChecker(*broken).run());
+            } catch (const std::runtime_error& e) {
+                std::cout << "Rejected: " << e.what() << std::endl;
+            }
+        }
+        std::filesystem::remove(countPath);
+        std::filesystem::remove(smallPath);
+
+        // Throughput: 4M vertices in 12 layers, 48M edges from lower to
+        // higher layers in random stream order
+        std::cout << "\n--- Throughput: 4M Vertices, 48M Edges, Random Order ---" << std::endl;
+        const uint32_t n = 1 << 22, layers = 12;
+        const size_t m = 48000000;
+        std::mt19937 rng(6);
+        auto layer = [&](uint32_t v) { return static_cast<uint32_t>((v * 0x9e3779b9u) >> 16) % layers; };
+        std::string path = dir + "/cyclic_semi.edges";
+        {
+            FILE* f = std::fopen(path.c_str(), "wb");
+            std::vector<uint32_t> chunk;
+            chunk.reserve(2 << 20);
+            size_t written = 0;
+            while (written < m) {
+                uint32_t u = rng() % n, v = rng() % n;
+                if (layer(u) == layer(v)) continue;
+                if (layer(u) > layer(v)) std::swap(u, v);
+                chunk.push_back(u);
+                chunk.push_back(v);
+                written++;
+                if (chunk.size() == chunk.capacity() || written == m) {
+                    std::fwrite(chunk.data(), 4, chunk.size(), f);
+                    chunk.clear();
+                }
+            }
+            std::fclose(f);
+        }
+        size_t fileBytes = std::filesystem::file_size(path);
+
+        FileEdgeSource file(path);
+        auto start = std::chrono::steady_clock::now();
+        SemiStreamingResult result = SemiStreamingChecker(file).run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printResult(result);
+        std::cout << "Stream: " << (fileBytes >> 20) << " MB, " << seconds << " s, "
+                  << static_cast<long long>(result.passes * (fileBytes >> 20) / seconds) << " MB/s over all passes, "
+                  << "working memory: " << (result.memoryBytes >> 20) << " MB" << std::endl;
+        std::filesystem::remove(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,319 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+// Sliding-window cycle detection over a stream of expiring edges.
+//
+// Live edges that keep the graph acyclic are held in a DAG whose topological
+// order is maintained incrementally (Pearce-Kelly). An edge that would close a
+// cycle is kept aside as a "closing" edge and reported through a FORMED event
+// together with the cycle it closes. That cycle doubles as a certificate: the
+// closing edge is only re-checked when one of the DAG edges on its cycle
+// expires. If it no longer closes a cycle it moves into the DAG and a
+// DISSOLVED event is emitted.
+
+struct CycleEvent {
+    enum Type { FORMED, DISSOLVED };
+    Type type;
+    long long time;            // insertion clock, or the expiry that dissolved the cycle
+    int from, to;              // closing edge
+    std::vector<int> cycle;    // witness for FORMED events
+};
+
+class StreamingCycleDetector {
+public:
+    using Callback = std::function<void(const CycleEvent&)>;
+
+    explicit StreamingCycleDetector(Callback onEvent) : onEvent(std::move(onEvent)) {}
+
+    // Insert (or refresh) edge u -> v, valid until `expiry`.
+    void insertEdge(int u, int v, long long expiry) {
+        ensureVertex(std::max(u, v));
+
+        uint64_t key = edgeKey(u, v);
+        auto it = edges.find(key);
+        if (it != edges.end()) {
+            // Refresh: the heap entry with the old expiry becomes stale.
+            if (expiry > it->second.expiry) {
+                it->second.expiry = expiry;
+                expiryHeap.push({expiry, key});
+            }
+            return;
+        }
+
+        edges[key] = {expiry, false};
+        expiryHeap.push({expiry, key});
+        if (!tryAddToDag(u, v)) {
+            edges[key].closing = true;
+            closingCount++;
+            std::vector<int> cycle = witnessCycle(u, v);
+            registerCertificate(key, cycle);
+            emit(CycleEvent::FORMED, now, u, v, std::move(cycle));
+        }
+    }
+
+    // Move the clock forward and expire every edge whose time has passed.
+    void advanceTo(long long time) {
+        if (time > now) now = time;
+        while (!expiryHeap.empty() && expiryHeap.top().first <= now) {
+            auto [expiry, key] = expiryHeap.top();
+            expiryHeap.pop();
+            auto it = edges.find(key);
+            if (it == edges.end() || it->second.expiry != expiry) {
+                continue; // stale heap entry
+            }
+            int u = fromOf(key), v = toOf(key);
+            bool wasClosing = it->second.closing;
+            edges.erase(it);
+            if (wasClosing) {
+                closingCount--;
+                emit(CycleEvent::DISSOLVED, expiry, u, v, {});
+            } else {
+                eraseFrom(out[u], v);
+                eraseFrom(in[v], u);
+                recheckDependents(key, expiry);
+            }
+        }
+    }
+
+    bool isCyclic() const { return closingCount > 0; }
+    size_t liveEdgeCount() const { return edges.size(); }
+
+private:
+    struct EdgeState {
+        long long expiry;
+        bool closing;
+    };
+
+    static uint64_t edgeKey(int u, int v) {
+        return (static_cast<uint64_t>(u) << 32) | static_cast<uint32_t>(v);
+    }
+    static int fromOf(uint64_t key) { return static_cast<int>(key >> 32); }
+    static int toOf(uint64_t key) { return static_cast<int>(key & 0xffffffffu); }
+
+    static void eraseFrom(std::vector<int>& list, int x) {
+        auto it = std::find(list.begin(), list.end(), x);
+        *it = list.back();
+        list.pop_back();
+    }
+
+    void ensureVertex(int v) {
+        while (static_cast<int>(ord.size()) <= v) {
+            int id = ord.size();
+            ord.push_back(id);
+            out.emplace_back();
+            in.emplace_back();
+            mark.push_back(0);
+        }
+    }
+
+    // Pearce-Kelly insertion. Returns false (leaving the DAG unchanged) if
+    // u -> v would close a cycle.
+    bool tryAddToDag(int u, int v) {
+        if (u == v) return false;
+        if (ord[u] < ord[v]) {
+            out[u].push_back(v);
+            in[v].push_back(u);
+            return true;
+        }
+
+        int lb = ord[v], ub = ord[u];
+        ++epoch;
+
+        // Forward search from v within the affected region
+        forward.clear();
+        stack.assign(1, v);
+        mark[v] = epoch;
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            forward.push_back(x);
+            for (int y : out[x]) {
+                if (y == u) return false;
+                if (mark[y] != epoch && ord[y] < ub) {
+                    mark[y] = epoch;
+                    stack.push_back(y);
+                }
+            }
+        }
+
+        // Backward search from u within the affected region
+        backward.clear();
+        stack.assign(1, u);
+        mark[u] = epoch;
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            backward.push_back(x);
+            for (int y : in[x]) {
+                if (mark[y] != epoch && ord[y] > lb) {
+                    mark[y] = epoch;
+                    stack.push_back(y);
+                }
+            }
+        }
+
+        // Reassign the pooled order slots: backward set first, then forward set
+        auto byOrd = [this](int a, int b) { return ord[a] < ord[b]; };
+        std::sort(forward.begin(), forward.end(), byOrd);
+        std::sort(backward.begin(), backward.end(), byOrd);
+        slots.clear();
+        for (int x : backward) slots.push_back(ord[x]);
+        for (int x : forward) slots.push_back(ord[x]);
+        std::sort(slots.begin(), slots.end());
+        size_t k = 0;
+        for (int x : backward) ord[x] = slots[k++];
+        for (int x : forward) ord[x] = slots[k++];
+
+        out[u].push_back(v);
+        in[v].push_back(u);
+        return true;
+    }
+
+    // Path v ~> u through the DAG, closed by u -> v.
+    std::vector<int> witnessCycle(int u, int v) {
+        if (u == v) return {u};
+        ++epoch;
+        std::unordered_map<int, int> parent;
+        std::queue<int> q;
+        q.push(v);
+        mark[v] = epoch;
+        while (!q.empty()) {
+            int x = q.front();
+            q.pop();
+            if (x == u) break;
+            for (int y : out[x]) {
+                if (mark[y] != epoch && ord[y] <= ord[u]) {
+                    mark[y] = epoch;
+                    parent[y] = x;
+                    q.push(y);
+                }
+            }
+        }
+        std::vector<int> path;
+        for (int x = u; x != v; x = parent[x]) path.push_back(x);
+        path.push_back(v);
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    // Remember which DAG edges the cycle of closing edge `key` relies on.
+    void registerCertificate(uint64_t key, const std::vector<int>& cycle) {
+        for (size_t i = 0; i + 1 < cycle.size(); ++i) {
+            dependents[edgeKey(cycle[i], cycle[i + 1])].push_back(key);
+        }
+    }
+
+    // A DAG edge expired at `time`: re-check the closing edges whose
+    // certificate used it. Entries for closing edges that have since expired
+    // or dissolved are stale and skipped.
+    void recheckDependents(uint64_t dagKey, long long time) {
+        auto dep = dependents.find(dagKey);
+        if (dep == dependents.end()) return;
+        std::vector<uint64_t> affected;
+        affected.swap(dep->second);
+        dependents.erase(dep);
+
+        for (uint64_t key : affected) {
+            auto it = edges.find(key);
+            if (it == edges.end() || !it->second.closing) continue;
+            int u = fromOf(key), v = toOf(key);
+            if (tryAddToDag(u, v)) {
+                it->second.closing = false;
+                closingCount--;
+                emit(CycleEvent::DISSOLVED, time, u, v, {});
+            } else {
+                registerCertificate(key, witnessCycle(u, v));
+            }
+        }
+    }
+
+    void emit(CycleEvent::Type type, long long time, int u, int v, std::vector<int> cycle) {
+        if (onEvent) onEvent(CycleEvent{type, time, u, v, std::move(cycle)});
+    }
+
+    Callback onEvent;
+    long long now = 0;
+
+    std::unordered_map<uint64_t, EdgeState> edges;
+    std::priority_queue<std::pair<long long, uint64_t>,
+                        std::vector<std::pair<long long, uint64_t>>,
+                        std::greater<>> expiryHeap;
+    std::unordered_map<uint64_t, std::vector<uint64_t>> dependents;
+    size_t closingCount = 0;
+
+    std::vector<int> ord;
+    std::vector<std::vector<int>> out, in;
+    std::vector<unsigned> mark;
+    unsigned epoch = 0;
+    std::vector<int> forward, backward, slots, stack;
+};
+
+void printEvent(const CycleEvent& e) {
+    if (e.type == CycleEvent::FORMED) {
+        std::cout << "[t=" << e.time << "] Cycle FORMED by edge " << e.from << " -> " << e.to << ": ";
+        for (size_t i = 0; i < e.cycle.size(); ++i) {
+            std::cout << e.cycle[i] << " -> ";
+        }
+        std::cout << e.cycle[0] << std::endl;
+    } else {
+        std::cout << "[t=" << e.time << "] Cycle DISSOLVED (edge " << e.from << " -> " << e.to << ")" << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "--- Sliding-Window Cycle Detection (Expiring Edge Stream) ---" << std::endl;
+
+    // Example: wait-for edges that close and then release a cycle
+    std::cout << "\n--- Test Case: Cycle Forms and Dissolves ---" << std::endl;
+    StreamingCycleDetector detector(printEvent);
+    detector.insertEdge(0, 1, 10);
+    detector.insertEdge(1, 2, 5);
+    detector.insertEdge(2, 0, 20); // Closes 0->1->2->0
+    detector.advanceTo(6);          // 1->2 expires, cycle dissolves
+    detector.insertEdge(1, 2, 30); // Closes it again
+    detector.advanceTo(21);         // 0->1 expires at t=10, cycle dissolves; 2->0 at t=20
+    std::cout << "Cyclic at t=21: " << (detector.isCyclic() ? "yes" : "no") << std::endl;
+
+    // Throughput: sparse wait-for style stream, mostly following a hidden
+    // order with occasional back edges, each edge live for 200K events
+    std::cout << "\n--- Throughput: Random Edge Stream ---" << std::endl;
+    const int numVertices = 100000;
+    const int numEvents = 5000000;
+    const long long window = 200000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> vertex(0, numVertices - 1);
+    std::uniform_int_distribution<int> coin(0, 99);
+
+    size_t formed = 0, dissolved = 0;
+    StreamingCycleDetector bench([&](const CycleEvent& e) {
+        (e.type == CycleEvent::FORMED ? formed : dissolved)++;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numEvents; ++i) {
+        long long t = i;
+        int a = vertex(rng), b = vertex(rng);
+        if (a == b) continue;
+        if ((a < b) == (coin(rng) != 0)) {
+            bench.insertEdge(a, b, t + window);
+        } else {
+            bench.insertEdge(b, a, t + window);
+        }
+        bench.advanceTo(t);
+    }
+    bench.advanceTo(numEvents + window);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Events: " << numEvents << ", cycles formed: " << formed
+              << ", dissolved: " << dissolved << std::endl;
+    std::cout << "Throughput: " << static_cast<long long>(numEvents / elapsed) << " events/s" << std::endl;
+
+    return 0;
+}
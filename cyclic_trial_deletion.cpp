@@ -0,0 +1,290 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+// Trial-deletion cycle collection (Bacon-Rajan synchronous collector).
+//
+// Reference counting frees everything except cycles. Objects whose count was
+// decremented to a non-zero value are registered as candidate roots; a
+// collection then runs three passes over the subgraph reachable from them:
+//   markGray   - subtract internal references (trial deletion)
+//   scan       - anything still externally referenced is restored (black),
+//                the rest turns white
+//   collect    - white objects reachable from a root form a garbage cycle
+//
+// The reference graph is supplied by the caller through a view, so the
+// collector never copies the object store and never touches its real counts:
+// trial counts live in the collector's own per-object arrays. The view must
+// provide
+//   size_t size() const;
+//   int refCount(int obj) const;
+//   template <class F> void forEachChild(int obj, F f) const;
+
+template <typename View>
+class TrialDeletionCollector {
+public:
+    explicit TrialDeletionCollector(const View& view) : view(view) {}
+
+    // Called when an object's count drops to a non-zero value.
+    void possibleRoot(int obj) {
+        grow();
+        if (color[obj] != PURPLE) {
+            color[obj] = PURPLE;
+            if (!buffered[obj]) {
+                buffered[obj] = true;
+                roots.push_back(obj);
+            }
+        }
+    }
+
+    // Run one collection over at most `maxRoots` buffered roots (all of them
+    // when 0). Returns the garbage cycles found; remaining roots stay
+    // buffered for the next batch.
+    std::vector<std::vector<int>> collectCycles(size_t maxRoots = 0) {
+        grow();
+        ++epoch;
+        size_t batch = (maxRoots == 0 || maxRoots > roots.size()) ? roots.size() : maxRoots;
+        std::vector<int> work(roots.end() - batch, roots.end());
+        roots.resize(roots.size() - batch);
+
+        markRoots(work);
+        for (int s : work) scan(s);
+
+        std::vector<std::vector<int>> garbage;
+        for (int s : work) buffered[s] = false;
+        for (int s : work) {
+            std::vector<int> cycle;
+            collectWhite(s, cycle);
+            if (!cycle.empty()) garbage.push_back(std::move(cycle));
+        }
+        return garbage;
+    }
+
+    size_t pendingRoots() const { return roots.size(); }
+    uint64_t referencesTraversed() const { return traversed; }
+
+private:
+    enum Color : uint8_t { BLACK, GRAY, WHITE, PURPLE };
+
+    void grow() {
+        size_t n = view.size();
+        if (color.size() < n) {
+            color.resize(n, BLACK);
+            buffered.resize(n, false);
+            trial.resize(n, 0);
+            stamp.resize(n, 0);
+        }
+    }
+
+    // Trial counts start from the live count the first time an object is
+    // touched in a collection.
+    int& trialCount(int obj) {
+        if (stamp[obj] != epoch) {
+            stamp[obj] = epoch;
+            trial[obj] = view.refCount(obj);
+        }
+        return trial[obj];
+    }
+
+    void markRoots(std::vector<int>& work) {
+        size_t kept = 0;
+        for (int s : work) {
+            if (color[s] == PURPLE && view.refCount(s) > 0) {
+                markGray(s);
+                work[kept++] = s;
+            } else {
+                // Either freed by its count or touched again since buffering
+                buffered[s] = false;
+            }
+        }
+        work.resize(kept);
+    }
+
+    void markGray(int s) {
+        if (color[s] == GRAY) return;
+        color[s] = GRAY;
+        trialCount(s);
+        stack.assign(1, s);
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            view.forEachChild(x, [&](int t) {
+                traversed++;
+                trialCount(t)--;
+                if (color[t] != GRAY) {
+                    color[t] = GRAY;
+                    stack.push_back(t);
+                }
+            });
+        }
+    }
+
+    void scan(int s) {
+        stack.assign(1, s);
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            if (color[x] != GRAY) continue;
+            if (trialCount(x) > 0) {
+                scanBlack(x);
+            } else {
+                color[x] = WHITE;
+                view.forEachChild(x, [&](int t) {
+                    traversed++;
+                    stack.push_back(t);
+                });
+            }
+        }
+    }
+
+    void scanBlack(int s) {
+        color[s] = BLACK;
+        blackStack.assign(1, s);
+        while (!blackStack.empty()) {
+            int x = blackStack.back();
+            blackStack.pop_back();
+            view.forEachChild(x, [&](int t) {
+                traversed++;
+                trialCount(t)++;
+                if (color[t] != BLACK) {
+                    color[t] = BLACK;
+                    blackStack.push_back(t);
+                }
+            });
+        }
+    }
+
+    // Every white object is garbage, including roots still buffered for a
+    // later batch: their color is no longer PURPLE, so that batch would drop
+    // them. Their buffered flag is cleared and markRoots discards the entry.
+    void collectWhite(int s, std::vector<int>& cycle) {
+        if (color[s] != WHITE) return;
+        color[s] = BLACK;
+        buffered[s] = false;
+        stack.assign(1, s);
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            cycle.push_back(x);
+            view.forEachChild(x, [&](int t) {
+                traversed++;
+                if (color[t] == WHITE) {
+                    color[t] = BLACK;
+                    buffered[t] = false;
+                    stack.push_back(t);
+                }
+            });
+        }
+    }
+
+    const View& view;
+    std::vector<int> roots;
+    std::vector<Color> color;
+    std::vector<bool> buffered;
+    std::vector<int> trial;
+    std::vector<uint32_t> stamp;
+    uint32_t epoch = 0;
+    std::vector<int> stack, blackStack;
+    uint64_t traversed = 0;
+};
+
+// Minimal reference-counted object store used by the examples.
+struct ObjectStore {
+    std::vector<int> counts;
+    std::vector<std::vector<int>> refs;
+
+    int create() {
+        counts.push_back(0);
+        refs.emplace_back();
+        return counts.size() - 1;
+    }
+    void addRef(int from, int to) {
+        refs[from].push_back(to);
+        counts[to]++;
+    }
+
+    size_t size() const { return counts.size(); }
+    int refCount(int obj) const { return counts[obj]; }
+    template <class F>
+    void forEachChild(int obj, F f) const {
+        for (int t : refs[obj]) f(t);
+    }
+};
+
+void printGarbage(const std::vector<std::vector<int>>& garbage) {
+    if (garbage.empty()) {
+        std::cout << "No garbage cycles." << std::endl;
+    }
+    for (const auto& cycle : garbage) {
+        std::cout << "Garbage cycle: ";
+        for (size_t i = 0; i < cycle.size(); ++i) {
+            std::cout << cycle[i] << (i == cycle.size() - 1 ? "" : ", ");
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "--- Trial-Deletion Cycle Collection (Bacon-Rajan) ---" << std::endl;
+
+    // Example: two 3-cycles, one still referenced from a live object
+    std::cout << "\n--- Test Case: Leaked and Live Cycles ---" << std::endl;
+    ObjectStore store;
+    for (int i = 0; i < 7; ++i) store.create();
+    store.addRef(0, 1); store.addRef(1, 2); store.addRef(2, 0); // leaked 0->1->2->0
+    store.addRef(3, 4); store.addRef(4, 5); store.addRef(5, 3); // live 3->4->5->3
+    store.addRef(6, 3);                                         // 6 holds the live cycle
+    store.counts[6]++;                                          // 6 is a stack root
+
+    TrialDeletionCollector<ObjectStore> collector(store);
+    collector.possibleRoot(0);
+    collector.possibleRoot(3);
+    printGarbage(collector.collectCycles());
+
+    // Example: a leaked 2-cycle whose objects are both roots, collected one
+    // root per batch; the second batch must not lose the other object
+    std::cout << "\n--- Test Case: Batched 2-Cycle ---" << std::endl;
+    ObjectStore pair;
+    pair.create();
+    pair.create();
+    pair.addRef(0, 1); pair.addRef(1, 0); // leaked 0<->1
+    TrialDeletionCollector<ObjectStore> pairCollector(pair);
+    pairCollector.possibleRoot(0);
+    pairCollector.possibleRoot(1);
+    while (pairCollector.pendingRoots() > 0) printGarbage(pairCollector.collectCycles(1));
+
+    // Throughput: many leaked rings plus live rings, collected in batches
+    std::cout << "\n--- Throughput: Batched Collection ---" << std::endl;
+    ObjectStore big;
+    const int numRings = 200000;
+    const int ringSize = 20;
+    for (int r = 0; r < numRings; ++r) {
+        int first = big.size();
+        for (int i = 0; i < ringSize; ++i) big.create();
+        for (int i = 0; i < ringSize; ++i) {
+            big.addRef(first + i, first + (i + 1) % ringSize);
+            big.addRef(first + i, first + (i + 7) % ringSize);
+        }
+        if (r % 4 == 0) big.counts[first]++; // every 4th ring is still live
+    }
+
+    TrialDeletionCollector<ObjectStore> bigCollector(big);
+    for (int r = 0; r < numRings; ++r) bigCollector.possibleRoot(r * ringSize);
+
+    size_t garbageCycles = 0, garbageObjects = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (bigCollector.pendingRoots() > 0) {
+        for (const auto& cycle : bigCollector.collectCycles(10000)) {
+            garbageCycles++;
+            garbageObjects += cycle.size();
+        }
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Garbage cycles: " << garbageCycles << " (" << garbageObjects << " objects)" << std::endl;
+    std::cout << "References traversed: " << bigCollector.referencesTraversed() << ", "
+              << static_cast<long long>(bigCollector.referencesTraversed() / elapsed) << " refs/s" << std::endl;
+
+    return 0;
+}
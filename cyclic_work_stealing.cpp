@@ -0,0 +1,884 @@
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <numa.h>
+
+// Work-stealing scheduler for the parallel detection engines, and a parallel
+// Kahn detector built on it.
+//
+// Workers are persistent threads pinned to the CPUs the process may use;
+// the thread calling run() takes part as worker 0. Each worker owns a
+// Chase-Lev deque: the owner pushes and pops at the bottom without locks or
+// read-modify-writes in the common case, thieves take the oldest task from
+// the top with one CAS.
+//
+// Fork-join is fork2(a, b): b is pushed as a task that lives on the
+// caller's stack, a runs inline, and b is popped back and run inline unless
+// it was stolen, in which case the caller executes other tasks until the
+// thief finishes it. A fork that is not stolen costs one push and one pop,
+// no allocation. parallelFor splits its range by lazy binary splitting: a
+// range is halved only while the worker's own deque is empty, i.e. while
+// some thief could still take the other half, so the grain adapts to the
+// load instead of being tuned per call (a minimum grain bounds the
+// overhead for tiny bodies).
+//
+// Idle workers spin on steal attempts for a while, then sleep; a push wakes
+// them only if someone is asleep, so busy phases pay a fence and one
+// relaxed load.
+//
+// NUMA: workers are split into contiguous groups, one per node, and pinned
+// to that node's CPUs. Vertex ranges are split over the nodes in the same
+// proportions (partition()). onEachNode() and parallelForLocal() hand each
+// node its part through a per-node mailbox that the node's workers check
+// before stealing, and thieves try workers of their own node before
+// crossing sockets. NumaArray places the graph and the per-vertex state
+// either on first touch, interleaved over all nodes, or partitioned so that
+// each node's vertex range (and its edges) lives in its own memory.
+// Link with -lnuma; without NUMA support everything runs as one node.
+
+class Task {
+public:
+    virtual void execute() = 0;
+    std::atomic<bool> done{false};
+
+protected:
+    ~Task() = default;
+};
+
+// Chase-Lev deque (with the memory orders of Le et al., "Correct and
+// Efficient Work-Stealing for Weak Memory Models"). Grows by doubling; old
+// buffers are kept until destruction since thieves may still read them.
+class ChaseLevDeque {
+public:
+    ChaseLevDeque() { buffers.emplace_back(new Buffer(1024)); array.store(buffers.back().get()); }
+
+    void push(Task* task) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* a = array.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) a = grow(a, t, b);
+        a->put(b, task);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only; nullptr if empty
+    Task* pop() {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Task* task = a->get(b);
+        if (t == b) {
+            // Last task: race against thieves for it
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) task = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    // Any thread; nullptr if empty or another thief won
+    Task* steal() {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        Task* task = array.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+        return task;
+    }
+
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(int64_t capacity) : capacity(capacity), slots(new std::atomic<Task*>[capacity]) {}
+        Task* get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, Task* task) { slots[i & (capacity - 1)].store(task, std::memory_order_relaxed); }
+        int64_t capacity;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+    };
+
+    Buffer* grow(Buffer* old, int64_t t, int64_t b) {
+        buffers.emplace_back(new Buffer(old->capacity * 2));
+        Buffer* a = buffers.back().get();
+        for (int64_t i = t; i < b; ++i) a->put(i, old->get(i));
+        array.store(a, std::memory_order_release);
+        return a;
+    }
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    alignas(64) std::atomic<Buffer*> array{nullptr};
+    std::vector<std::unique_ptr<Buffer>> buffers;
+};
+
+// Nodes that hold CPUs this process may run on, with those CPUs
+struct NumaTopology {
+    std::vector<int> nodeIds;
+    std::vector<std::vector<int>> nodeCpus;
+
+    static NumaTopology detect() {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        sched_getaffinity(0, sizeof(allowed), &allowed);
+        bool numa = numa_available() >= 0;
+        NumaTopology topology;
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (!CPU_ISSET(c, &allowed)) continue;
+            int node = numa ? std::max(0, numa_node_of_cpu(c)) : 0;
+            auto it = std::find(topology.nodeIds.begin(), topology.nodeIds.end(), node);
+            if (it == topology.nodeIds.end()) {
+                topology.nodeIds.push_back(node);
+                topology.nodeCpus.emplace_back();
+                it = topology.nodeIds.end() - 1;
+            }
+            topology.nodeCpus[it - topology.nodeIds.begin()].push_back(c);
+        }
+        return topology;
+    }
+};
+
+class Scheduler {
+public:
+    explicit Scheduler(unsigned numWorkers = std::max(1u, std::thread::hardware_concurrency()), bool pin = true,
+                       NumaTopology topology = NumaTopology::detect())
+        : topology(std::move(topology)), workers(std::max(1u, numWorkers)) {
+        // Contiguous worker groups per node; nodes beyond the worker count
+        // stay unused
+        unsigned nodes = std::min<size_t>(this->topology.nodeIds.size(), workers.size());
+        this->topology.nodeIds.resize(nodes);
+        this->topology.nodeCpus.resize(nodes);
+        nodeFirstWorker.resize(nodes + 1);
+        for (unsigned k = 0; k <= nodes; ++k) nodeFirstWorker[k] = k * workers.size() / nodes;
+        mailboxes = std::vector<Mailbox>(nodes);
+        for (unsigned k = 0; k < nodes; ++k) {
+            for (unsigned w = nodeFirstWorker[k]; w < nodeFirstWorker[k + 1]; ++w) workers[w].node = k;
+        }
+        for (unsigned w = 1; w < workers.size(); ++w) {
+            workers[w].thread = std::thread([this, w, pin] {
+                const std::vector<int>& cpus = this->topology.nodeCpus[workers[w].node];
+                if (pin) pinTo(cpus[(w - nodeFirstWorker[workers[w].node]) % cpus.size()]);
+                workerLoop(w);
+            });
+        }
+    }
+
+    ~Scheduler() {
+        {
+            std::lock_guard<std::mutex> guard(sleepMutex);
+            shutdown = true;
+            wakeups++;
+        }
+        sleepCv.notify_all();
+        for (unsigned w = 1; w < workers.size(); ++w) workers[w].thread.join();
+    }
+
+    unsigned numWorkers() const { return workers.size(); }
+    unsigned numNodes() const { return mailboxes.size(); }
+    int nodeId(unsigned node) const { return topology.nodeIds[node]; }
+    const NumaTopology& nodes() const { return topology; }
+
+    // Split of [0, n) over the nodes, proportional to their workers:
+    // node k owns [split[k], split[k + 1])
+    std::vector<size_t> partition(size_t n) const {
+        std::vector<size_t> split(numNodes() + 1);
+        for (unsigned k = 0; k <= numNodes(); ++k) split[k] = n * nodeFirstWorker[k] / workers.size();
+        return split;
+    }
+
+    // Worker index of the calling thread inside this scheduler's run()
+    unsigned currentWorker() const { return current.scheduler == this ? current.worker : 0; }
+    unsigned currentNode() const { return workers[currentWorker()].node; }
+
+    // Runs f with the calling thread as worker 0; fork2 and parallelFor
+    // inside f are spread over all workers. One run() at a time.
+    template <class F>
+    void run(F&& f) {
+        if (current.scheduler == this) {
+            f();
+            return;
+        }
+        std::lock_guard<std::mutex> guard(runMutex);
+        Context saved = current;
+        current = {this, 0};
+        wake();
+        f();
+        current = saved;
+    }
+
+    // a and b may run in parallel; returns when both are done
+    template <class A, class B>
+    void fork2(A&& a, B&& b) {
+        if (current.scheduler != this) {
+            run([&] { fork2(a, b); });
+            return;
+        }
+        Worker& me = workers[current.worker];
+        Job<B> job(b);
+        me.deque.push(&job);
+        // Orders the push before the sleepers check; pairs with the seq_cst
+        // announcement in workerLoop, so either the sleeper sees the task or
+        // this sees the sleeper
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) > 0) wake();
+        a();
+        Task* task = me.deque.pop();
+        // Thieves take the oldest tasks first, so if `job` was stolen the
+        // deque is empty and pop cannot return an older task
+        if (task == &job) {
+            b();
+            return;
+        }
+        waitFor(job);
+    }
+
+    // f(node) for every node, each preferably run by that node's workers
+    // (node 0 by the caller); returns when all are done
+    template <class F>
+    void onEachNode(F&& f) {
+        run([&] {
+            std::vector<std::unique_ptr<NodeJob<F>>> jobs;
+            for (unsigned k = 1; k < numNodes(); ++k) {
+                jobs.emplace_back(new NodeJob<F>(f, k));
+                std::lock_guard<std::mutex> guard(mailboxes[k].pushMutex);
+                mailboxes[k].deque.push(jobs.back().get());
+            }
+            if (!jobs.empty()) wake();
+            f(0u);
+            for (auto& job : jobs) waitFor(*job);
+        });
+    }
+
+    // parallelFor with [begin, end) split by partition(): each node's
+    // workers start on their own part, stealing balances what is left
+    template <class Body>
+    void parallelForLocal(size_t begin, size_t end, Body&& body, size_t minGrain = 256) {
+        if (begin >= end) return;
+        std::vector<size_t> split = partition(end - begin);
+        onEachNode([&](unsigned k) {
+            if (split[k] < split[k + 1]) splitRange(begin + split[k], begin + split[k + 1], body, std::max<size_t>(1, minGrain));
+        });
+    }
+
+    // body(begin, end) over [begin, end); ranges are at least minGrain long
+    template <class Body>
+    void parallelFor(size_t begin, size_t end, Body&& body, size_t minGrain = 256) {
+        if (begin >= end) return;
+        run([&] { splitRange(begin, end, body, std::max<size_t>(1, minGrain)); });
+    }
+
+    // Whether a caller holding divisible work should split it: nothing is
+    // left on its deque for idle workers to steal
+    bool shouldSplit() const {
+        return workers.size() > 1 && current.scheduler == this && workers[current.worker].deque.empty();
+    }
+
+    size_t steals() const { return stolen.load(); }
+    size_t crossNodeSteals() const { return remoteSteals.load(); }
+
+private:
+    template <class F>
+    struct Job final : Task {
+        explicit Job(F& f) : f(f) {}
+        void execute() override {
+            f();
+            done.store(true, std::memory_order_release);
+        }
+        F& f;
+    };
+
+    template <class F>
+    struct NodeJob final : Task {
+        NodeJob(F& f, unsigned node) : f(f), node(node) {}
+        void execute() override {
+            f(node);
+            done.store(true, std::memory_order_release);
+        }
+        F& f;
+        unsigned node;
+    };
+
+    struct alignas(64) Worker {
+        ChaseLevDeque deque;
+        std::thread thread;
+        unsigned node = 0;
+    };
+
+    // Tasks addressed to a node; pushes come from any thread, so they are
+    // serialized, and every worker takes from the top like a thief
+    struct Mailbox {
+        ChaseLevDeque deque;
+        std::mutex pushMutex;
+    };
+
+    // Runs other tasks until `task`, taken by some thief, is done
+    void waitFor(Task& task) {
+        while (!task.done.load(std::memory_order_acquire)) {
+            if (Task* other = findWork(current.worker)) {
+                other->execute();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    struct Context {
+        Scheduler* scheduler;
+        unsigned worker;
+    };
+    static thread_local Context current;
+
+    // Lazy binary splitting: split while nobody has work to steal from us
+    template <class Body>
+    void splitRange(size_t begin, size_t end, Body& body, size_t minGrain) {
+        // With the deque non-empty, work through the range in minGrain steps,
+        // splitting the rest as soon as the deque drains
+        while (end - begin > minGrain) {
+            if (shouldSplit()) {
+                size_t mid = begin + (end - begin) / 2;
+                fork2([&] { splitRange(begin, mid, body, minGrain); }, [&] { splitRange(mid, end, body, minGrain); });
+                return;
+            }
+            body(begin, begin + minGrain);
+            begin += minGrain;
+        }
+        body(begin, end);
+    }
+
+    // Own deque, own node's mailbox, same-node workers, then the other
+    // nodes (their workers first, their mailboxes last)
+    Task* findWork(unsigned w) {
+        if (Task* task = workers[w].deque.pop()) return task;
+        unsigned node = workers[w].node;
+        if (Task* task = mailboxes[node].deque.steal()) return task;
+        if (Task* task = stealFrom(w, nodeFirstWorker[node], nodeFirstWorker[node + 1])) return task;
+        for (unsigned i = 1; i < numNodes(); ++i) {
+            unsigned k = (node + i) % numNodes();
+            if (Task* task = stealFrom(w, nodeFirstWorker[k], nodeFirstWorker[k + 1])) {
+                remoteSteals.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        for (unsigned i = 1; i < numNodes(); ++i) {
+            if (Task* task = mailboxes[(node + i) % numNodes()].deque.steal()) return task;
+        }
+        return nullptr;
+    }
+
+    // Random first victim in [first, last) spreads thieves over the deques
+    Task* stealFrom(unsigned w, unsigned first, unsigned last) {
+        unsigned n = last - first;
+        unsigned start = static_cast<unsigned>(rng(w)) % n;
+        for (unsigned i = 0; i < n; ++i) {
+            unsigned victim = first + (start + i) % n;
+            if (victim == w) continue;
+            if (Task* task = workers[victim].deque.steal()) {
+                stolen.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    static uint64_t rng(unsigned w) {
+        thread_local uint64_t state = 0x9e3779b97f4a7c15ULL * (w + 1);
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    void workerLoop(unsigned w) {
+        current = {this, w};
+        uint64_t seen = 0;
+        int idle = 0;
+        while (true) {
+            if (Task* task = findWork(w)) {
+                task->execute();
+                idle = 0;
+                continue;
+            }
+            if (++idle < SPIN_ROUNDS) {
+                std::this_thread::yield();
+                continue;
+            }
+            // Announce the sleep, then look once more: a push that missed
+            // the announcement happened before this check and is found here
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (Task* task = findWork(w)) {
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+                task->execute();
+                idle = 0;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCv.wait(lock, [&] { return wakeups != seen; });
+            seen = wakeups;
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (shutdown) return;
+            idle = 0;
+        }
+    }
+
+    void wake() {
+        {
+            std::lock_guard<std::mutex> guard(sleepMutex);
+            wakeups++;
+        }
+        sleepCv.notify_all();
+    }
+
+    static void pinTo(int cpu) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    static constexpr int SPIN_ROUNDS = 2000;
+    NumaTopology topology;
+    std::vector<Worker> workers;
+    std::vector<unsigned> nodeFirstWorker;
+    std::vector<Mailbox> mailboxes;
+    std::mutex runMutex, sleepMutex;
+    std::condition_variable sleepCv;
+    uint64_t wakeups = 0;
+    bool shutdown = false;
+    std::atomic<int> sleepers{0};
+    std::atomic<size_t> stolen{0}, remoteSteals{0};
+};
+
+thread_local Scheduler::Context Scheduler::current = {nullptr, 0};
+
+struct CSRGraph {
+    std::vector<uint32_t> offsets, targets;
+
+    uint32_t numVertices() const { return offsets.size() - 1; }
+
+    static CSRGraph fromEdges(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+        CSRGraph g;
+        g.offsets.assign(n + 1, 0);
+        for (const auto& e : edges) g.offsets[e.first + 1]++;
+        for (uint32_t i = 0; i < n; ++i) g.offsets[i + 1] += g.offsets[i];
+        g.targets.resize(edges.size());
+        std::vector<uint32_t> fill(g.offsets.begin(), g.offsets.end() - 1);
+        for (const auto& e : edges) g.targets[fill[e.first]++] = e.second;
+        return g;
+    }
+};
+
+enum class Placement { FIRST_TOUCH, INTERLEAVED, PARTITIONED };
+
+const char* placementName(Placement p) {
+    switch (p) {
+        case Placement::FIRST_TOUCH: return "first touch";
+        case Placement::INTERLEAVED: return "interleaved";
+        default: return "partitioned";
+    }
+}
+
+// Fixed-size array in its own mapping, so its pages can carry a NUMA
+// policy. Elements start zeroed; T must be trivially destructible.
+// PARTITIONED binds [split[k], split[k + 1]) to node k (the scheduler's
+// vertex partition unless given), rounded to page boundaries.
+template <typename T>
+class NumaArray {
+public:
+    NumaArray(size_t n, Placement placement, const Scheduler& scheduler, std::vector<size_t> split = {}) : n(n) {
+        static_assert(std::is_trivially_destructible<T>::value, "NumaArray does not run destructors");
+        bytes = std::max<size_t>(1, n * sizeof(T));
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        items = static_cast<T*>(p);
+        if (numa_available() < 0 || scheduler.numNodes() < 2) return;
+        if (placement == Placement::INTERLEAVED) {
+            numa_interleave_memory(p, bytes, numa_all_nodes_ptr);
+        } else if (placement == Placement::PARTITIONED) {
+            if (split.empty()) split = scheduler.partition(n);
+            size_t page = numa_pagesize();
+            for (unsigned k = 0; k < scheduler.numNodes(); ++k) {
+                size_t lo = split[k] * sizeof(T) / page * page;
+                size_t hi = k + 1 == scheduler.numNodes() ? bytes : split[k + 1] * sizeof(T) / page * page;
+                if (hi > lo) numa_tonode_memory(static_cast<char*>(p) + lo, hi - lo, scheduler.nodeId(k));
+            }
+        }
+    }
+    NumaArray(NumaArray&& other) noexcept : items(other.items), n(other.n), bytes(other.bytes) { other.items = nullptr; }
+    NumaArray(const NumaArray&) = delete;
+    NumaArray& operator=(const NumaArray&) = delete;
+    ~NumaArray() {
+        if (items) munmap(items, bytes);
+    }
+
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+    size_t size() const { return n; }
+
+private:
+    T* items;
+    size_t n, bytes;
+};
+
+// CSR copied into NUMA-placed arrays. Partitioned placement puts each
+// node's vertex range and the edges of those vertices on that node.
+struct PlacedCSR {
+    NumaArray<uint32_t> offsets, targets;
+
+    uint32_t numVertices() const { return offsets.size() - 1; }
+
+    // FIRST_TOUCH copies on the calling thread, which is the usual way a
+    // graph ends up on one node; the others copy node-locally
+    static PlacedCSR place(const CSRGraph& g, Scheduler& scheduler, Placement placement) {
+        uint32_t n = g.numVertices();
+        std::vector<size_t> vertexSplit = scheduler.partition(n), edgeSplit;
+        for (size_t v : vertexSplit) edgeSplit.push_back(g.offsets[v]);
+        PlacedCSR placed{NumaArray<uint32_t>(n + 1, placement, scheduler, vertexSplit),
+                         NumaArray<uint32_t>(g.targets.size(), placement, scheduler, edgeSplit)};
+        auto copy = [&](size_t b, size_t e) {
+            for (size_t v = b; v < e; ++v) placed.offsets[v] = g.offsets[v];
+            for (size_t i = g.offsets[b]; i < g.offsets[e]; ++i) placed.targets[i] = g.targets[i];
+        };
+        if (placement == Placement::FIRST_TOUCH) {
+            copy(0, n);
+        } else {
+            scheduler.parallelForLocal(0, n, copy, 4096);
+        }
+        placed.offsets[n] = g.offsets[n];
+        return placed;
+    }
+};
+
+// Sequential baseline: Kahn's algorithm, then the same parent walk as the
+// parallel detector.
+std::vector<uint32_t> detectCycleSequential(const CSRGraph& g) {
+    uint32_t n = g.numVertices();
+    std::vector<uint32_t> inDegree(n, 0), queue;
+    for (uint32_t t : g.targets) inDegree[t]++;
+    queue.reserve(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (inDegree[v] == 0) queue.push_back(v);
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        uint32_t u = queue[head];
+        for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            if (--inDegree[g.targets[i]] == 0) queue.push_back(g.targets[i]);
+        }
+    }
+    if (queue.size() == n) return {};
+
+    std::vector<uint32_t>& parent = inDegree;
+    std::vector<uint8_t> removed(n, 0);
+    for (uint32_t v : queue) removed[v] = 1;
+    for (uint32_t u = 0; u < n; ++u) {
+        if (removed[u]) continue;
+        for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            if (!removed[g.targets[i]]) parent[g.targets[i]] = u;
+        }
+    }
+    uint32_t v = 0;
+    while (removed[v]) ++v;
+    std::vector<uint32_t> mark(n, UINT32_MAX), path;
+    while (mark[v] == UINT32_MAX) {
+        mark[v] = path.size();
+        path.push_back(v);
+        v = parent[v];
+    }
+    std::vector<uint32_t> cycle(path.begin() + mark[v], path.end());
+    std::reverse(cycle.begin(), cycle.end());
+    return cycle;
+}
+
+// Parallel detection on the scheduler:
+//   1. in-degrees with atomic increments (parallelFor over vertices),
+//   2. Kahn without levels: the sources are split over the workers, each
+//      task keeps the vertices it frees on a local stack and hands half of
+//      that stack to a fork whenever its deque is empty. Deep DAGs with
+//      narrow levels would otherwise pay a parallel round per level,
+//   3. if vertices remain, each of them still has a remaining predecessor;
+//      one parallel pass over their edges records one such parent each, and
+//      walking parents from any remaining vertex must close a cycle.
+// Graph is CSRGraph or PlacedCSR. The per-vertex state follows `placement`,
+// and every pass starts each node on its own vertex range.
+template <typename Graph>
+class ParallelCycleDetector {
+public:
+    ParallelCycleDetector(const Graph& g, Scheduler& scheduler, Placement placement)
+        : g(g), scheduler(scheduler), inDegree(g.numVertices(), placement, scheduler),
+          removed(g.numVertices(), placement, scheduler) {}
+
+    std::vector<uint32_t> run() {
+        uint32_t n = g.numVertices();
+        // First touch by each node's workers, whatever the placement
+        scheduler.parallelForLocal(0, n, [&](size_t b, size_t e) {
+            for (size_t v = b; v < e; ++v) inDegree[v].store(0, std::memory_order_relaxed);
+        }, 4096);
+        scheduler.parallelForLocal(0, n, [&](size_t b, size_t e) {
+            for (size_t i = g.offsets[b]; i < g.offsets[e]; ++i) inDegree[g.targets[i]].fetch_add(1, std::memory_order_relaxed);
+        }, 4096);
+        if (kahn() == n) return {};
+
+        // Any remaining predecessor will do, so racing stores are fine
+        NumaArray<std::atomic<uint32_t>>& parent = inDegree;
+        scheduler.parallelForLocal(0, n, [&](size_t b, size_t e) {
+            for (size_t u = b; u < e; ++u) {
+                if (removed[u]) continue;
+                for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                    if (!removed[g.targets[i]]) parent[g.targets[i]].store(u, std::memory_order_relaxed);
+                }
+            }
+        }, 4096);
+
+        uint32_t v = 0;
+        while (removed[v]) ++v;
+        std::vector<uint32_t> mark(n, UINT32_MAX), path;
+        while (mark[v] == UINT32_MAX) {
+            mark[v] = path.size();
+            path.push_back(v);
+            v = parent[v].load(std::memory_order_relaxed);
+        }
+        std::vector<uint32_t> cycle(path.begin() + mark[v], path.end());
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+
+private:
+    // Removes every source and everything freed by that; returns the count.
+    // Each node starts draining from the sources in its own range.
+    uint32_t kahn() {
+        uint32_t n = g.numVertices();
+        std::vector<std::vector<uint32_t>> buffers(scheduler.numWorkers());
+        scheduler.parallelForLocal(0, n, [&](size_t b, size_t e) {
+            std::vector<uint32_t>& out = buffers[scheduler.currentWorker()];
+            for (size_t v = b; v < e; ++v) {
+                if (inDegree[v].load(std::memory_order_relaxed) == 0) out.push_back(v);
+            }
+        }, 4096);
+        // Stolen ranges end up in another node's buffers, so sort by owner
+        std::vector<size_t> split = scheduler.partition(n);
+        std::vector<std::vector<uint32_t>> sources(scheduler.numNodes());
+        for (const auto& buffer : buffers) {
+            for (uint32_t v : buffer) sources[std::upper_bound(split.begin(), split.end(), v) - split.begin() - 1].push_back(v);
+        }
+        std::atomic<uint32_t> count{0};
+        scheduler.onEachNode([&](unsigned k) { drain(sources[k], count); });
+        return count.load();
+    }
+
+    void drain(std::vector<uint32_t>& stack, std::atomic<uint32_t>& count) {
+        uint32_t local = 0;
+        while (!stack.empty()) {
+            if (stack.size() >= 2 * MIN_SPLIT && scheduler.shouldSplit()) {
+                std::vector<uint32_t> half(stack.begin() + stack.size() / 2, stack.end());
+                stack.resize(stack.size() / 2);
+                scheduler.fork2([&] { drain(stack, count); }, [&] { drain(half, count); });
+                break;
+            }
+            uint32_t u = stack.back();
+            stack.pop_back();
+            removed[u] = 1;
+            local++;
+            // A vertex is freed by exactly one decrement, so each is pushed once
+            for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                uint32_t t = g.targets[i];
+                if (inDegree[t].fetch_sub(1, std::memory_order_relaxed) == 1) stack.push_back(t);
+            }
+        }
+        count.fetch_add(local, std::memory_order_relaxed);
+    }
+
+    static constexpr size_t MIN_SPLIT = 64;
+    const Graph& g;
+    Scheduler& scheduler;
+    NumaArray<std::atomic<uint32_t>> inDegree;
+    NumaArray<uint8_t> removed;
+};
+
+template <typename Graph>
+std::vector<uint32_t> detectCycleParallel(const Graph& g, Scheduler& scheduler,
+                                          Placement placement = Placement::FIRST_TOUCH) {
+    return ParallelCycleDetector<Graph>(g, scheduler, placement).run();
+}
+
+void printCycle(const std::vector<uint32_t>& cycle) {
+    if (cycle.empty()) {
+        std::cout << "Result: Graph is ACYCLIC." << std::endl;
+        return;
+    }
+    std::cout << "Result: Graph is CYCLIC. Vertices in a cycle: ";
+    for (uint32_t v : cycle) std::cout << v << " -> ";
+    std::cout << cycle[0] << std::endl;
+}
+
+// Whether `cycle` is a non-empty cycle of g
+bool isCycleOf(const CSRGraph& g, const std::vector<uint32_t>& cycle) {
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        uint32_t u = cycle[i], v = cycle[(i + 1) % cycle.size()];
+        if (!std::binary_search(g.targets.begin() + g.offsets[u], g.targets.begin() + g.offsets[u + 1], v)) return false;
+    }
+    return !cycle.empty();
+}
+
+long fib(Scheduler& s, int k) {
+    if (k < 2) return k;
+    long a, b;
+    s.fork2([&] { a = fib(s, k - 1); }, [&] { b = fib(s, k - 2); });
+    return a + b;
+}
+
+int main() {
+    std::cout << "--- Work-Stealing Scheduler ---" << std::endl;
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Hardware threads: " << hardwareThreads << std::endl;
+    Scheduler scheduler(std::max(4u, hardwareThreads));
+
+    // Example: the 4-vertex test case
+    std::cout << "\n--- Test Case: Cyclic Graph ---" << std::endl;
+    CSRGraph small = CSRGraph::fromEdges(4, {{0, 1}, {1, 2}, {1, 3}, {3, 1}});
+    printCycle(detectCycleParallel(small, scheduler));
+
+    // Differential test of the multi-node paths (mailboxes, partitioned
+    // ranges, cross-node steals, per-node page binding) on any host: 2 and
+    // 3 logical nodes that all map to the first real node, against the
+    // sequential detector on acyclic and cyclic random graphs
+    std::cout << "\n--- Test Case: Fake Multi-Node Topology ---" << std::endl;
+    NumaTopology host = NumaTopology::detect();
+    for (unsigned fakeNodes : {2u, 3u}) {
+        NumaTopology fake;
+        fake.nodeIds.assign(fakeNodes, host.nodeIds[0]);
+        fake.nodeCpus.assign(fakeNodes, host.nodeCpus[0]);
+        Scheduler multi(4, false, fake);
+        bool agree = true;
+        for (int trial = 0; trial < 8; ++trial) {
+            const uint32_t vertices = 50000;
+            std::mt19937 graphRng(trial);
+            std::vector<std::pair<uint32_t, uint32_t>> randomEdges;
+            for (uint32_t u = 0; u + 1 < vertices; ++u) {
+                for (int k = 0; k < 4; ++k) randomEdges.push_back({u, u + 1 + graphRng() % std::min<uint32_t>(vertices - u - 1, 1000)});
+            }
+            // Odd trials close a cycle through a back edge
+            if (trial % 2) randomEdges.push_back({vertices - 1 - graphRng() % 100, graphRng() % vertices / 2});
+            std::sort(randomEdges.begin(), randomEdges.end());
+            CSRGraph random = CSRGraph::fromEdges(vertices, randomEdges);
+            bool cyclic = !detectCycleSequential(random).empty();
+            for (Placement placement : {Placement::FIRST_TOUCH, Placement::INTERLEAVED, Placement::PARTITIONED}) {
+                PlacedCSR placed = PlacedCSR::place(random, multi, placement);
+                std::vector<uint32_t> found = detectCycleParallel(placed, multi, placement);
+                if (found.empty() == cyclic || (cyclic && !isCycleOf(random, found))) {
+                    agree = false;
+                    std::cout << "Mismatch: trial " << trial << ", placement " << placementName(placement) << std::endl;
+                }
+            }
+        }
+        std::cout << "Nodes: " << multi.numNodes() << ", 8 graphs x 3 placements match sequential: "
+                  << (agree ? "yes" : "no") << ", cross-node steals: " << multi.crossNodeSteals() << std::endl;
+    }
+
+    // Fork overhead: fib(30) forks 1.3M times, almost all of them not stolen
+    std::cout << "\n--- Throughput: Fork-Join Overhead ---" << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    long value = 0;
+    scheduler.run([&] { value = fib(scheduler, 30); });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t forks = 1346268;
+    std::cout << "fib(30) = " << value << ", " << forks << " forks in " << seconds << " s ("
+              << seconds * 1e9 / forks << " ns per fork, " << scheduler.steals() << " steals)" << std::endl;
+
+    // Per-call latency: a small parallel loop on the persistent pool against
+    // spawning a thread per chunk for every call
+    const int calls = 2000;
+    std::vector<uint32_t> data(1 << 14, 1);
+    std::atomic<uint64_t> sink{0};
+    start = std::chrono::steady_clock::now();
+    for (int c = 0; c < calls; ++c) {
+        scheduler.parallelFor(0, data.size(), [&](size_t b, size_t e) {
+            uint64_t sum = 0;
+            for (size_t i = b; i < e; ++i) sum += data[i];
+            sink.fetch_add(sum, std::memory_order_relaxed);
+        }, 1024);
+    }
+    double poolSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int c = 0; c < calls; ++c) {
+        std::vector<std::thread> pool;
+        size_t chunk = data.size() / scheduler.numWorkers();
+        for (unsigned t = 0; t < scheduler.numWorkers(); ++t) {
+            pool.emplace_back([&, t] {
+                uint64_t sum = 0;
+                for (size_t i = t * chunk; i < (t + 1) * chunk; ++i) sum += data[i];
+                sink.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (auto& th : pool) th.join();
+    }
+    double spawnSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "16K-element loop, " << calls << " calls: pool " << poolSeconds * 1e6 / calls
+              << " us/call, thread per call " << spawnSeconds * 1e6 / calls << " us/call" << std::endl;
+
+    // Detection: 4M vertices, 32M forward edges plus one back edge
+    std::cout << "\n--- Throughput: 4M Vertices, 32M Edges ---" << std::endl;
+    const uint32_t n = 1 << 22;
+    std::mt19937 rng(71);
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(8 * static_cast<size_t>(n) + 1);
+    for (uint32_t u = 0; u + 1 < n; ++u) {
+        for (int k = 0; k < 8; ++k) edges.push_back({u, u + 1 + rng() % std::min<uint32_t>(n - u - 1, 1 << 16)});
+    }
+    edges.push_back({n - 1, n / 2});
+    CSRGraph big = CSRGraph::fromEdges(n, edges);
+    edges.clear();
+    edges.shrink_to_fit();
+
+    start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> cycle = detectCycleSequential(big);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Sequential: " << seconds << " s, cycle length " << cycle.size() << std::endl;
+    for (unsigned threads = 1; threads <= std::max(4u, hardwareThreads); threads *= 2) {
+        Scheduler pool(threads);
+        start = std::chrono::steady_clock::now();
+        cycle = detectCycleParallel(big, pool);
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Workers: " << threads << ", " << seconds << " s, cycle length " << cycle.size()
+                  << ", steals: " << pool.steals() << std::endl;
+    }
+
+    // Same graph and state arrays under each NUMA placement, all workers
+    std::cout << "\n--- Throughput: NUMA Placement ---" << std::endl;
+    std::cout << "Nodes: " << scheduler.numNodes() << " (";
+    for (unsigned k = 0; k < scheduler.numNodes(); ++k) {
+        std::cout << (k ? ", " : "") << "node " << scheduler.nodeId(k) << ": " << scheduler.nodes().nodeCpus[k].size()
+                  << " CPUs";
+    }
+    std::cout << ")" << std::endl;
+    for (Placement placement : {Placement::FIRST_TOUCH, Placement::INTERLEAVED, Placement::PARTITIONED}) {
+        PlacedCSR placed = PlacedCSR::place(big, scheduler, placement);
+        size_t crossBefore = scheduler.crossNodeSteals();
+        start = std::chrono::steady_clock::now();
+        cycle = detectCycleParallel(placed, scheduler, placement);
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Placement " << placementName(placement) << ": " << seconds << " s, cycle length " << cycle.size()
+                  << ", cross-node steals: " << scheduler.crossNodeSteals() - crossBefore << std::endl;
+    }
+
+    return 0;
+}